@@ -0,0 +1,201 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#include "LibArena.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+void arena_init(Arena* arena, size_t block_size){
+    if(arena == NULL) return;
+
+    arena->first = NULL;
+    arena->current = NULL;
+    arena->block_size = block_size > 0 ? block_size : ARENA_DEFAULT_BLOCK_SIZE;
+}
+
+static Arena_Block* __internal_arena_new_block(size_t capacity){
+    Arena_Block* block = (Arena_Block*)malloc(sizeof(Arena_Block) + capacity);
+    if(block == NULL){
+        fprintf(stderr, "[ERROR] Could not allocate memory\n");
+        return NULL;
+    }
+
+    block->next = NULL;
+    block->capacity = capacity;
+    block->used = 0;
+
+    return block;
+}
+
+//Offset in block at which size bytes aligned to alignment fit, or SIZE_MAX
+static size_t __internal_arena_fit(Arena_Block* block, size_t size, size_t alignment){
+    uintptr_t base = (uintptr_t)block->data;
+    uintptr_t aligned = (base + block->used + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    size_t offset = (size_t)(aligned - base);
+
+    if(offset > block->capacity || block->capacity - offset < size) return SIZE_MAX;
+
+    return offset;
+}
+
+void* arena_alloc_aligned(Arena* arena, size_t size, size_t alignment){
+    if(arena == NULL) return NULL;
+
+    if(alignment == 0) alignment = sizeof(max_align_t);
+    if((alignment & (alignment - 1)) != 0){
+        fprintf(stderr, "[ERROR] arena_alloc_aligned alignment %zu is not a power of two\n", alignment);
+        return NULL;
+    }
+
+    //A fresh block must hold the header, size bytes and the alignment padding without wrapping
+    if(size > SIZE_MAX - alignment - sizeof(Arena_Block)){
+        fprintf(stderr, "[ERROR] arena_alloc_aligned size %zu is too large\n", size);
+        return NULL;
+    }
+
+    if(arena->block_size == 0) arena->block_size = ARENA_DEFAULT_BLOCK_SIZE;
+
+    Arena_Block* block = arena->current;
+
+    if(block != NULL){
+        size_t offset = __internal_arena_fit(block, size, alignment);
+        if(offset != SIZE_MAX){
+            block->used = offset + size;
+            return (unsigned char*)block->data + offset;
+        }
+
+        //Blocks left behind by a rewind are reused before growing the chain
+        while(block->next != NULL){
+            block = block->next;
+            block->used = 0;
+
+            offset = __internal_arena_fit(block, size, alignment);
+            if(offset != SIZE_MAX){
+                arena->current = block;
+                block->used = offset + size;
+                return (unsigned char*)block->data + offset;
+            }
+        }
+    }
+
+    size_t capacity = arena->block_size;
+    if(capacity < size + alignment) capacity = size + alignment;
+
+    Arena_Block* fresh = __internal_arena_new_block(capacity);
+    if(fresh == NULL) return NULL;
+
+    size_t offset = __internal_arena_fit(fresh, size, alignment);
+    if(offset == SIZE_MAX){
+        fprintf(stderr, "[ERROR] arena_alloc_aligned could not fit %zu bytes in a new block\n", size);
+        free(fresh);
+        return NULL;
+    }
+
+    if(block == NULL) arena->first = fresh;
+    else block->next = fresh;
+    arena->current = fresh;
+
+    fresh->used = offset + size;
+
+    return (unsigned char*)fresh->data + offset;
+}
+
+void* arena_alloc(Arena* arena, size_t size){
+    return arena_alloc_aligned(arena, size, sizeof(max_align_t));
+}
+
+void* arena_alloc_zero(Arena* arena, size_t size){
+    void* memory = arena_alloc(arena, size);
+    if(memory != NULL) memset(memory, 0, size);
+    return memory;
+}
+
+char* arena_strndup(Arena* arena, const char* string, size_t size){
+    char* copy = (char*)arena_alloc_aligned(arena, size + 1, 1);
+    if(copy == NULL) return NULL;
+
+    memcpy(copy, string, size);
+    copy[size] = '\0';
+
+    return copy;
+}
+
+Arena_Mark arena_mark(Arena* arena){
+    Arena_Mark mark = {0};
+
+    if(arena == NULL || arena->current == NULL) return mark;
+
+    mark.block = arena->current;
+    mark.used = arena->current->used;
+
+    return mark;
+}
+
+void arena_rewind(Arena* arena, Arena_Mark mark){
+    if(arena == NULL) return;
+
+    if(mark.block == NULL){
+        arena_reset(arena);
+        return;
+    }
+
+    arena->current = mark.block;
+    arena->current->used = mark.used;
+}
+
+void arena_reset(Arena* arena){
+    if(arena == NULL) return;
+
+    arena->current = arena->first;
+    if(arena->current != NULL) arena->current->used = 0;
+}
+
+void arena_free(Arena* arena){
+    if(arena == NULL) return;
+
+    Arena_Block* block = arena->first;
+    while(block != NULL){
+        Arena_Block* next = block->next;
+        free(block);
+        block = next;
+    }
+
+    arena->first = NULL;
+    arena->current = NULL;
+}
+
+Arena_Scope arena_scope_begin(Arena* arena){
+    Arena_Scope scope = {0};
+
+    scope.arena = arena;
+    scope.mark = arena_mark(arena);
+
+    return scope;
+}
+
+void arena_scope_end(Arena_Scope* scope){
+    if(scope == NULL) return;
+    arena_rewind(scope->arena, scope->mark);
+}
@@ -0,0 +1,80 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#define ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+
+typedef struct Arena_Block
+{
+    struct Arena_Block* next;
+    size_t capacity;
+    size_t used;
+    max_align_t data[];
+}Arena_Block;
+
+typedef struct
+{
+    Arena_Block* first;
+    Arena_Block* current;
+    size_t block_size;
+}Arena;
+
+typedef struct
+{
+    Arena_Block* block;
+    size_t used;
+}Arena_Mark;
+
+typedef struct
+{
+    Arena* arena;
+    Arena_Mark mark;
+}Arena_Scope;
+
+void arena_init(Arena* arena, size_t block_size);
+void* arena_alloc(Arena* arena, size_t size);
+void* arena_alloc_aligned(Arena* arena, size_t size, size_t alignment);
+void* arena_alloc_zero(Arena* arena, size_t size);
+char* arena_strndup(Arena* arena, const char* string, size_t size);
+
+Arena_Mark arena_mark(Arena* arena);
+void arena_rewind(Arena* arena, Arena_Mark mark);
+void arena_reset(Arena* arena);
+void arena_free(Arena* arena);
+
+Arena_Scope arena_scope_begin(Arena* arena);
+void arena_scope_end(Arena_Scope* scope);
+
+//Everything allocated from arena after ARENA_SCOPE is released when the enclosing block exits
+#if defined(__GNUC__) || defined(__clang__)
+    #define __internal_arena_concat(a, b) a##b
+    #define __internal_arena_name(line) __internal_arena_concat(__internal_arena_scope_, line)
+    #define ARENA_SCOPE(arena) \
+        Arena_Scope __internal_arena_name(__LINE__) __attribute__((cleanup(arena_scope_end))) = arena_scope_begin(arena)
+#endif
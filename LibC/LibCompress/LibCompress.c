@@ -0,0 +1,956 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#include "LibCompress.h"
+#include "../LibString/LibStringBuilder.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#ifdef __linux__
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include "../LibFile/LibFile.h"
+#endif
+
+#define COMPRESS_MIN_MATCH 4
+//The format requires the last 5 bytes to be literals and the last match to start 12 bytes before the end
+#define COMPRESS_LAST_LITERALS 5
+#define COMPRESS_MF_LIMIT 12
+#define COMPRESS_MAX_DISTANCE 65535
+#define COMPRESS_HASH_LOG 14
+//Every 2^6 failed probes the search step grows by one, so incompressible data is skipped quickly
+#define COMPRESS_SKIP_TRIGGER 6
+#define COMPRESS_FRAME_HEADER_SIZE 6
+
+enum{
+    DECOMPRESS_STAGE_HEADER = 0,
+    DECOMPRESS_STAGE_CONTENT_SIZE,
+    DECOMPRESS_STAGE_BLOCK_HEADER,
+    DECOMPRESS_STAGE_BLOCK,
+    DECOMPRESS_STAGE_CHECKSUM,
+    DECOMPRESS_STAGE_DONE
+};
+
+static inline uint32_t __internal_compress_read32(const uint8_t* p){
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline uint64_t __internal_compress_read64(const uint8_t* p){
+    uint64_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline uint32_t __internal_compress_load_le32(const uint8_t* p){
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static inline uint64_t __internal_compress_load_le64(const uint8_t* p){
+    return (uint64_t)__internal_compress_load_le32(p) | (uint64_t)__internal_compress_load_le32(p + 4) << 32;
+}
+
+static inline void __internal_compress_store_le32(uint8_t* p, uint32_t value){
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+}
+
+static inline void __internal_compress_store_le64(uint8_t* p, uint64_t value){
+    __internal_compress_store_le32(p, (uint32_t)value);
+    __internal_compress_store_le32(p + 4, (uint32_t)(value >> 32));
+}
+
+static inline uint32_t __internal_compress_hash(uint32_t sequence){
+    return (sequence * 2654435761u) >> (32 - COMPRESS_HASH_LOG);
+}
+
+//Length of the common prefix of p and match, without reading at or past limit
+static inline size_t __internal_compress_count(const uint8_t* p, const uint8_t* match, const uint8_t* limit){
+    const uint8_t* start = p;
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    while(limit - p >= 8){
+        uint64_t difference = __internal_compress_read64(p) ^ __internal_compress_read64(match);
+        if(difference != 0) return (size_t)(p - start) + ((size_t)__builtin_ctzll(difference) >> 3);
+
+        p += 8;
+        match += 8;
+    }
+#endif
+
+    while(p < limit && *p == *match){
+        p++;
+        match++;
+    }
+
+    return (size_t)(p - start);
+}
+
+static inline uint8_t* __internal_compress_write_length(uint8_t* op, size_t length){
+    while(length >= 255){
+        *op++ = 255;
+        length -= 255;
+    }
+    *op++ = (uint8_t)length;
+
+    return op;
+}
+
+size_t compress_block_bound(size_t size){
+    return size + size / 255 + 16;
+}
+
+size_t compress_block(const void* source, size_t size, void* destination, size_t capacity){
+    if(source == NULL || destination == NULL) return 0;
+
+    //Match positions are stored as 32 bit offsets from the start of the block
+    if(size > 0x7E000000){
+        fprintf(stderr, "[ERROR] compress_block(%zu) block is too large\n", size);
+        return 0;
+    }
+
+    const uint8_t* src = (const uint8_t*)source;
+    const uint8_t* ip = src;
+    const uint8_t* anchor = src;
+    const uint8_t* iend = src + size;
+
+    uint8_t* op = (uint8_t*)destination;
+    uint8_t* oend = op + capacity;
+
+    if(size >= COMPRESS_MF_LIMIT + 1){
+        uint32_t table[1 << COMPRESS_HASH_LOG];
+        memset(table, 0, sizeof(table));
+
+        const uint8_t* mflimit = iend - COMPRESS_MF_LIMIT;
+        const uint8_t* matchlimit = iend - COMPRESS_LAST_LITERALS;
+
+        table[__internal_compress_hash(__internal_compress_read32(ip))] = 0;
+        ip++;
+
+        for(;;){
+            const uint8_t* match = NULL;
+            const uint8_t* forward = ip;
+            unsigned attempts = 1u << COMPRESS_SKIP_TRIGGER;
+            bool found = false;
+
+            while(found == false){
+                ip = forward;
+                forward = ip + (attempts++ >> COMPRESS_SKIP_TRIGGER);
+                if(forward > mflimit) break;
+
+                uint32_t sequence = __internal_compress_read32(ip);
+                uint32_t hash = __internal_compress_hash(sequence);
+                match = src + table[hash];
+                table[hash] = (uint32_t)(ip - src);
+
+                found = ip - match <= COMPRESS_MAX_DISTANCE && __internal_compress_read32(match) == sequence;
+            }
+            if(found == false) break;
+
+            //Extend the match backwards over bytes that were going to be literals
+            while(ip > anchor && match > src && ip[-1] == match[-1]){
+                ip--;
+                match--;
+            }
+
+            size_t literal_length = (size_t)(ip - anchor);
+            size_t match_length = __internal_compress_count(ip + COMPRESS_MIN_MATCH, match + COMPRESS_MIN_MATCH, matchlimit);
+
+            //Token, both length extensions, literals and offset
+            size_t needed = 1 + literal_length / 255 + 1 + literal_length + 2 + match_length / 255 + 1;
+            if((size_t)(oend - op) < needed + COMPRESS_LAST_LITERALS + 1) return 0;
+
+            uint8_t* token = op++;
+            if(literal_length >= 15){
+                *token = 15 << 4;
+                op = __internal_compress_write_length(op, literal_length - 15);
+            }
+            else{
+                *token = (uint8_t)(literal_length << 4);
+            }
+
+            memcpy(op, anchor, literal_length);
+            op += literal_length;
+
+            uint16_t offset = (uint16_t)(ip - match);
+            *op++ = (uint8_t)offset;
+            *op++ = (uint8_t)(offset >> 8);
+
+            if(match_length >= 15){
+                *token |= 15;
+                op = __internal_compress_write_length(op, match_length - 15);
+            }
+            else{
+                *token |= (uint8_t)match_length;
+            }
+
+            ip += match_length + COMPRESS_MIN_MATCH;
+            anchor = ip;
+
+            if(ip > mflimit) break;
+
+            table[__internal_compress_hash(__internal_compress_read32(ip - 2))] = (uint32_t)(ip - 2 - src);
+        }
+    }
+
+    size_t literal_length = (size_t)(iend - anchor);
+    size_t needed = 1 + (literal_length >= 15 ? (literal_length - 15) / 255 + 1 : 0) + literal_length;
+    if((size_t)(oend - op) < needed) return 0;
+
+    if(literal_length >= 15){
+        *op++ = 15 << 4;
+        op = __internal_compress_write_length(op, literal_length - 15);
+    }
+    else{
+        *op++ = (uint8_t)(literal_length << 4);
+    }
+
+    memcpy(op, anchor, literal_length);
+    op += literal_length;
+
+    return (size_t)(op - (uint8_t*)destination);
+}
+
+static inline bool __internal_decompress_length(const uint8_t** ip, const uint8_t* iend, size_t* length){
+    unsigned byte;
+
+    do{
+        if(*ip >= iend) return false;
+        byte = *(*ip)++;
+        *length += byte;
+    }while(byte == 255);
+
+    return true;
+}
+
+//Copies a match that may overlap its own output. Whole 8 or 16 byte moves run up to 15 bytes
+//past op + length, so the caller leaves that much room.
+static inline void __internal_decompress_wild_match(uint8_t* op, const uint8_t* match, size_t offset, size_t length){
+    uint8_t* end = op + length;
+
+    if(offset < 8){
+        //Spread the first 8 bytes of the period, after which the source is at least 8 bytes behind
+        static const uint8_t forward[8] = {0, 1, 2, 1, 0, 4, 4, 4};
+        static const int8_t back[8] = {0, 0, 0, -1, -4, 1, 2, 3};
+
+        op[0] = match[0];
+        op[1] = match[1];
+        op[2] = match[2];
+        op[3] = match[3];
+        match += forward[offset];
+        memcpy(op + 4, match, 4);
+        match -= back[offset];
+        op += 8;
+    }
+
+    if(offset < 16){
+        while(op < end){
+            memcpy(op, match, 8);
+            op += 8;
+            match += 8;
+        }
+    }
+    else{
+        do{
+            memcpy(op, match, 16);
+            op += 16;
+            match += 16;
+        }while(op < end);
+    }
+}
+
+bool decompress_block(const void* source, size_t size, void* destination, size_t capacity, size_t* decompressed_size){
+    if(source == NULL || destination == NULL || size == 0) return false;
+
+    const uint8_t* ip = (const uint8_t*)source;
+    const uint8_t* iend = ip + size;
+
+    uint8_t* ostart = (uint8_t*)destination;
+    uint8_t* op = ostart;
+    uint8_t* oend = op + capacity;
+
+    for(;;){
+        //A block cannot end on a match
+        if(ip >= iend) return false;
+        unsigned token = *ip++;
+        size_t length = token >> 4;
+
+        //Most literal runs are short: with enough slack on both sides they are copied with one
+        //fixed 16 byte move. It cannot be the last sequence since at least four input bytes follow.
+        if(length != 15 && iend - ip >= 18 && oend - op >= 32){
+            memcpy(op, ip, 16);
+            op += length;
+            ip += length;
+        }
+        else{
+            if(length == 15 && __internal_decompress_length(&ip, iend, &length) == false) return false;
+
+            if((size_t)(iend - ip) < length || (size_t)(oend - op) < length) return false;
+
+            memcpy(op, ip, length);
+            op += length;
+            ip += length;
+
+            //The last sequence of a block is literals only
+            if(ip == iend) break;
+
+            if(iend - ip < 2) return false;
+        }
+
+        size_t offset = (size_t)ip[0] | (size_t)ip[1] << 8;
+        ip += 2;
+
+        //An offset of 0 wraps around and is rejected with the ones reaching before the block
+        if(offset - 1 >= (size_t)(op - ostart)) return false;
+
+        const uint8_t* match = op - offset;
+        length = token & 15;
+
+        //Short matches at least 8 bytes back are three fixed moves
+        if(length != 15 && offset >= 8 && oend - op >= 18){
+            memcpy(op, match, 8);
+            memcpy(op + 8, match + 8, 8);
+            memcpy(op + 16, match + 16, 2);
+            op += length + COMPRESS_MIN_MATCH;
+            continue;
+        }
+
+        if(length == 15 && __internal_decompress_length(&ip, iend, &length) == false) return false;
+        length += COMPRESS_MIN_MATCH;
+
+        if((size_t)(oend - op) < length) return false;
+
+        if((size_t)(oend - op) - length >= 16){
+            __internal_decompress_wild_match(op, match, offset, length);
+            op += length;
+        }
+        else{
+            //Near the end of the output, byte by byte so the repeat with period offset stays right
+            uint8_t* end = op + length;
+            while(op < end){
+                *op++ = *match++;
+            }
+        }
+    }
+
+    if(decompressed_size != NULL) *decompressed_size = (size_t)(op - ostart);
+    return true;
+}
+
+static size_t __internal_compress_block_size(const Compress_Options* options, uint8_t* code){
+    size_t requested = options != NULL && options->block_size != 0 ? options->block_size : COMPRESS_DEFAULT_BLOCK_SIZE;
+
+    size_t block_size = COMPRESS_MIN_BLOCK_SIZE;
+    uint8_t block_code = 0;
+
+    while(block_size < requested && block_size < COMPRESS_MAX_BLOCK_SIZE){
+        block_size <<= 1;
+        block_code++;
+    }
+
+    if(code != NULL) *code = block_code;
+    return block_size;
+}
+
+static void __internal_compress_set_stats(Compress_Stats* stats, uint64_t uncompressed_size, uint64_t compressed_size){
+    if(stats == NULL) return;
+
+    stats->uncompressed_size = uncompressed_size;
+    stats->compressed_size = compressed_size;
+    stats->ratio = compressed_size > 0 ? compute_compression_ratio((float)uncompressed_size, (float)compressed_size) : 0.0f;
+    stats->space_saving = uncompressed_size > 0 ? compute_space_saving((float)compressed_size, (float)uncompressed_size) : 0.0f;
+}
+
+static size_t __internal_compress_write_header(uint8_t* p, uint8_t flags, uint8_t code, uint64_t content_size){
+    __internal_compress_store_le32(p, COMPRESS_FRAME_MAGIC);
+    p[4] = flags;
+    p[5] = code;
+
+    if((flags & COMPRESS_FRAME_FLAG_CONTENT_SIZE) == 0) return COMPRESS_FRAME_HEADER_SIZE;
+
+    __internal_compress_store_le64(p + COMPRESS_FRAME_HEADER_SIZE, content_size);
+    return COMPRESS_FRAME_HEADER_SIZE + 8;
+}
+
+//Compresses one block behind its header, storing it when compression does not make it smaller
+static size_t __internal_compress_frame_block(const uint8_t* source, size_t size, uint8_t* destination){
+    size_t compressed = compress_block(source, size, destination + 4, size - 1);
+
+    if(compressed == 0){
+        __internal_compress_store_le32(destination, (uint32_t)size | COMPRESS_BLOCK_STORED);
+        memcpy(destination + 4, source, size);
+        return size + 4;
+    }
+
+    __internal_compress_store_le32(destination, (uint32_t)compressed);
+    return compressed + 4;
+}
+
+size_t compress_frame_bound(size_t size, const Compress_Options* options){
+    size_t block_size = __internal_compress_block_size(options, NULL);
+    size_t blocks = (size + block_size - 1) / block_size;
+
+    return COMPRESS_FRAME_HEADER_SIZE + 8 + blocks * 4 + size + 4 + 8;
+}
+
+bool compress_buffer(const void* source, size_t size, void** destination, size_t* destination_size, const Compress_Options* options, Compress_Stats* stats){
+    if((source == NULL && size > 0) || destination == NULL || destination_size == NULL) return false;
+
+    uint8_t code;
+    size_t block_size = __internal_compress_block_size(options, &code);
+    bool checksum = options == NULL || options->checksum;
+
+    uint8_t* output = (uint8_t*)malloc(compress_frame_bound(size, options));
+    if(output == NULL){
+        fprintf(stderr, "[ERROR] Could not allocate memory\n");
+        return false;
+    }
+
+    uint8_t flags = COMPRESS_FRAME_FLAG_CONTENT_SIZE | (checksum ? COMPRESS_FRAME_FLAG_CHECKSUM : 0);
+    uint8_t* op = output + __internal_compress_write_header(output, flags, code, size);
+
+    const uint8_t* ip = (const uint8_t*)source;
+    for(size_t remaining = size; remaining > 0;){
+        size_t chunk = remaining < block_size ? remaining : block_size;
+
+        op += __internal_compress_frame_block(ip, chunk, op);
+        ip += chunk;
+        remaining -= chunk;
+    }
+
+    __internal_compress_store_le32(op, 0);
+    op += 4;
+
+    if(checksum){
+        __internal_compress_store_le64(op, hash_xxh64(source, size, 0));
+        op += 8;
+    }
+
+    *destination = output;
+    *destination_size = (size_t)(op - output);
+    __internal_compress_set_stats(stats, size, *destination_size);
+
+    return true;
+}
+
+static bool __internal_compress_builder_write(void* user_data, const void* data, size_t size){
+    return sb_append_buffer((String_Builder*)user_data, data, size);
+}
+
+bool decompress_buffer(const void* source, size_t size, void** destination, size_t* destination_size, Compress_Stats* stats){
+    if(source == NULL || destination == NULL || destination_size == NULL) return false;
+
+    const uint8_t* ip = (const uint8_t*)source;
+    const uint8_t* iend = ip + size;
+
+    if(size < COMPRESS_FRAME_HEADER_SIZE || __internal_compress_load_le32(ip) != COMPRESS_FRAME_MAGIC || ip[5] > 6){
+        fprintf(stderr, "[ERROR] Not a compressed frame\n");
+        return false;
+    }
+
+    uint8_t flags = ip[4];
+
+    //Without the content size the output has to grow as the blocks come in
+    if((flags & COMPRESS_FRAME_FLAG_CONTENT_SIZE) == 0){
+        String_Builder builder;
+        sb_init(&builder);
+
+        Decompress_Stream stream;
+        if(decompress_stream_init(&stream, __internal_compress_builder_write, &builder) == false) return false;
+
+        bool written = decompress_stream_write(&stream, source, size);
+        if(decompress_stream_end(&stream, stats) == false || written == false){
+            sb_free(&builder);
+            return false;
+        }
+
+        *destination_size = builder.size;
+        *destination = sb_to_cstr(&builder);
+        return *destination != NULL;
+    }
+
+    size_t block_size = (size_t)COMPRESS_MIN_BLOCK_SIZE << ip[5];
+    if(size < COMPRESS_FRAME_HEADER_SIZE + 8){
+        fprintf(stderr, "[ERROR] Compressed frame is truncated\n");
+        return false;
+    }
+
+    uint64_t content_size = __internal_compress_load_le64(ip + COMPRESS_FRAME_HEADER_SIZE);
+    ip += COMPRESS_FRAME_HEADER_SIZE + 8;
+
+    //A block expands at most about 255 times, a larger claim is a corrupt header
+    if(content_size > (uint64_t)size * 255 + block_size || content_size >= SIZE_MAX){
+        fprintf(stderr, "[ERROR] Compressed frame is corrupted\n");
+        return false;
+    }
+
+    uint8_t* output = (uint8_t*)malloc(content_size > 0 ? (size_t)content_size : 1);
+    if(output == NULL){
+        fprintf(stderr, "[ERROR] Could not allocate memory\n");
+        return false;
+    }
+
+    uint8_t* op = output;
+    uint8_t* oend = output + content_size;
+    bool valid = false;
+
+    for(;;){
+        if(iend - ip < 4) break;
+
+        uint32_t header = __internal_compress_load_le32(ip);
+        ip += 4;
+
+        if(header == 0){
+            valid = op == oend;
+            break;
+        }
+
+        size_t block_data = header & ~COMPRESS_BLOCK_STORED;
+        size_t room = (size_t)(oend - op) < block_size ? (size_t)(oend - op) : block_size;
+        if(block_data > (size_t)(iend - ip) || block_data > block_size) break;
+
+        size_t produced;
+        if(header & COMPRESS_BLOCK_STORED){
+            if(block_data > room) break;
+            memcpy(op, ip, block_data);
+            produced = block_data;
+        }
+        else if(decompress_block(ip, block_data, op, room, &produced) == false){
+            break;
+        }
+
+        op += produced;
+        ip += block_data;
+    }
+
+    if(valid && (flags & COMPRESS_FRAME_FLAG_CHECKSUM)){
+        valid = iend - ip >= 8 && __internal_compress_load_le64(ip) == hash_xxh64(output, (size_t)content_size, 0);
+        ip += 8;
+    }
+
+    if(valid == false){
+        fprintf(stderr, "[ERROR] Compressed frame is corrupted\n");
+        free(output);
+        return false;
+    }
+
+    *destination = output;
+    *destination_size = (size_t)content_size;
+    __internal_compress_set_stats(stats, content_size, (uint64_t)(ip - (const uint8_t*)source));
+
+    return true;
+}
+
+static bool __internal_compress_emit(Compress_Stream* stream, const void* data, size_t size){
+    if(stream->write(stream->user_data, data, size) == false){
+        fprintf(stderr, "[ERROR] Could not write compressed stream\n");
+        stream->failed = true;
+        return false;
+    }
+
+    stream->stats.compressed_size += size;
+    return true;
+}
+
+bool compress_stream_init(Compress_Stream* stream, Compress_Write_Callback write, void* user_data, const Compress_Options* options){
+    if(stream == NULL || write == NULL) return false;
+
+    memset(stream, 0, sizeof(*stream));
+
+    uint8_t code;
+    stream->write = write;
+    stream->user_data = user_data;
+    stream->block_size = __internal_compress_block_size(options, &code);
+    stream->checksum = options == NULL || options->checksum;
+
+    stream->input = (uint8_t*)malloc(stream->block_size);
+    stream->output = (uint8_t*)malloc(stream->block_size + 4);
+    if(stream->input == NULL || stream->output == NULL){
+        fprintf(stderr, "[ERROR] Could not allocate memory\n");
+        free(stream->input);
+        free(stream->output);
+        return false;
+    }
+
+    hash_xxh64_init(&stream->hash, 0);
+
+    uint8_t header[COMPRESS_FRAME_HEADER_SIZE];
+    __internal_compress_write_header(header, stream->checksum ? COMPRESS_FRAME_FLAG_CHECKSUM : 0, code, 0);
+
+    if(__internal_compress_emit(stream, header, sizeof(header)) == false){
+        free(stream->input);
+        free(stream->output);
+        return false;
+    }
+
+    return true;
+}
+
+static bool __internal_compress_stream_block(Compress_Stream* stream, const uint8_t* data, size_t size){
+    if(stream->checksum) hash_xxh64_update(&stream->hash, data, size);
+    stream->stats.uncompressed_size += size;
+
+    size_t produced = __internal_compress_frame_block(data, size, stream->output);
+    return __internal_compress_emit(stream, stream->output, produced);
+}
+
+bool compress_stream_write(Compress_Stream* stream, const void* data, size_t size){
+    if(stream == NULL || stream->failed) return false;
+    if(data == NULL) return size == 0;
+
+    const uint8_t* p = (const uint8_t*)data;
+
+    if(stream->input_size > 0){
+        size_t taken = stream->block_size - stream->input_size;
+        if(taken > size) taken = size;
+
+        memcpy(stream->input + stream->input_size, p, taken);
+        stream->input_size += taken;
+        p += taken;
+        size -= taken;
+
+        if(stream->input_size < stream->block_size) return true;
+
+        if(__internal_compress_stream_block(stream, stream->input, stream->block_size) == false) return false;
+        stream->input_size = 0;
+    }
+
+    //Whole blocks are compressed straight from the caller's buffer
+    while(size >= stream->block_size){
+        if(__internal_compress_stream_block(stream, p, stream->block_size) == false) return false;
+        p += stream->block_size;
+        size -= stream->block_size;
+    }
+
+    memcpy(stream->input, p, size);
+    stream->input_size = size;
+
+    return true;
+}
+
+bool compress_stream_end(Compress_Stream* stream, Compress_Stats* stats){
+    if(stream == NULL) return false;
+
+    bool result = stream->failed == false;
+
+    if(result && stream->input_size > 0){
+        result = __internal_compress_stream_block(stream, stream->input, stream->input_size);
+    }
+
+    if(result){
+        uint8_t trailer[12];
+        size_t trailer_size = 4;
+
+        __internal_compress_store_le32(trailer, 0);
+        if(stream->checksum){
+            __internal_compress_store_le64(trailer + 4, hash_xxh64_final(&stream->hash));
+            trailer_size += 8;
+        }
+
+        result = __internal_compress_emit(stream, trailer, trailer_size);
+    }
+
+    if(result) __internal_compress_set_stats(stats, stream->stats.uncompressed_size, stream->stats.compressed_size);
+
+    free(stream->input);
+    free(stream->output);
+    stream->input = NULL;
+    stream->output = NULL;
+
+    return result;
+}
+
+bool decompress_stream_init(Decompress_Stream* stream, Compress_Write_Callback write, void* user_data){
+    if(stream == NULL || write == NULL) return false;
+
+    memset(stream, 0, sizeof(*stream));
+
+    stream->write = write;
+    stream->user_data = user_data;
+    stream->stage = DECOMPRESS_STAGE_HEADER;
+    stream->needed = COMPRESS_FRAME_HEADER_SIZE;
+    hash_xxh64_init(&stream->hash, 0);
+
+    return true;
+}
+
+static bool __internal_decompress_fail(Decompress_Stream* stream, const char* message){
+    fprintf(stderr, "[ERROR] %s\n", message);
+    stream->failed = true;
+    return false;
+}
+
+//Decodes one complete block and passes its content on
+static bool __internal_decompress_stream_block(Decompress_Stream* stream, const uint8_t* data, size_t size){
+    const uint8_t* content = data;
+    size_t produced = size;
+
+    if((stream->block_header & COMPRESS_BLOCK_STORED) == 0){
+        if(decompress_block(data, size, stream->output, stream->block_size, &produced) == false){
+            return __internal_decompress_fail(stream, "Compressed frame is corrupted");
+        }
+        content = stream->output;
+    }
+
+    if(stream->flags & COMPRESS_FRAME_FLAG_CHECKSUM) hash_xxh64_update(&stream->hash, content, produced);
+    stream->stats.uncompressed_size += produced;
+
+    if(produced > 0 && stream->write(stream->user_data, content, produced) == false){
+        return __internal_decompress_fail(stream, "Could not write decompressed stream");
+    }
+
+    return true;
+}
+
+//Moves the state machine on once the bytes the current stage waits for are complete
+static bool __internal_decompress_advance(Decompress_Stream* stream){
+    const uint8_t* header = stream->header;
+
+    switch(stream->stage){
+        case DECOMPRESS_STAGE_HEADER:
+            if(__internal_compress_load_le32(header) != COMPRESS_FRAME_MAGIC || header[5] > 6){
+                return __internal_decompress_fail(stream, "Not a compressed frame");
+            }
+
+            stream->flags = header[4];
+            stream->block_size = (size_t)COMPRESS_MIN_BLOCK_SIZE << header[5];
+            stream->block = (uint8_t*)malloc(stream->block_size);
+            stream->output = (uint8_t*)malloc(stream->block_size);
+            if(stream->block == NULL || stream->output == NULL){
+                return __internal_decompress_fail(stream, "Could not allocate memory");
+            }
+
+            stream->stage = stream->flags & COMPRESS_FRAME_FLAG_CONTENT_SIZE ? DECOMPRESS_STAGE_CONTENT_SIZE : DECOMPRESS_STAGE_BLOCK_HEADER;
+            stream->needed = stream->stage == DECOMPRESS_STAGE_CONTENT_SIZE ? 8 : 4;
+            break;
+
+        case DECOMPRESS_STAGE_CONTENT_SIZE:
+            //Checked against what was produced once the end mark arrives
+            memcpy(stream->header + 8, header, 8);
+            stream->stage = DECOMPRESS_STAGE_BLOCK_HEADER;
+            stream->needed = 4;
+            break;
+
+        case DECOMPRESS_STAGE_BLOCK_HEADER:
+            stream->block_header = __internal_compress_load_le32(header);
+
+            if(stream->block_header == 0){
+                bool checksum = stream->flags & COMPRESS_FRAME_FLAG_CHECKSUM;
+                stream->stage = checksum ? DECOMPRESS_STAGE_CHECKSUM : DECOMPRESS_STAGE_DONE;
+                stream->needed = checksum ? 8 : 0;
+                break;
+            }
+
+            stream->needed = stream->block_header & ~COMPRESS_BLOCK_STORED;
+            if(stream->needed == 0 || stream->needed > stream->block_size){
+                return __internal_decompress_fail(stream, "Compressed frame is corrupted");
+            }
+
+            stream->stage = DECOMPRESS_STAGE_BLOCK;
+            stream->block_filled = 0;
+            break;
+
+        case DECOMPRESS_STAGE_CHECKSUM:
+            if(__internal_compress_load_le64(header) != hash_xxh64_final(&stream->hash)){
+                return __internal_decompress_fail(stream, "Compressed frame checksum does not match");
+            }
+            stream->stage = DECOMPRESS_STAGE_DONE;
+            stream->needed = 0;
+            break;
+    }
+
+    stream->header_size = 0;
+    return true;
+}
+
+bool decompress_stream_write(Decompress_Stream* stream, const void* data, size_t size){
+    if(stream == NULL || stream->failed) return false;
+    if(data == NULL) return size == 0;
+
+    const uint8_t* p = (const uint8_t*)data;
+
+    while(size > 0){
+        if(stream->stage == DECOMPRESS_STAGE_DONE){
+            return __internal_decompress_fail(stream, "Unexpected data after the end of the compressed frame");
+        }
+
+        if(stream->stage == DECOMPRESS_STAGE_BLOCK){
+            //A block that arrives whole is decoded in place without buffering it
+            if(stream->block_filled == 0 && size >= stream->needed){
+                size_t block_data = stream->needed;
+                if(__internal_decompress_stream_block(stream, p, block_data) == false) return false;
+
+                p += block_data;
+                size -= block_data;
+                stream->stats.compressed_size += block_data;
+                stream->stage = DECOMPRESS_STAGE_BLOCK_HEADER;
+                stream->needed = 4;
+                continue;
+            }
+
+            size_t taken = stream->needed - stream->block_filled;
+            if(taken > size) taken = size;
+
+            memcpy(stream->block + stream->block_filled, p, taken);
+            stream->block_filled += taken;
+            stream->stats.compressed_size += taken;
+            p += taken;
+            size -= taken;
+
+            if(stream->block_filled == stream->needed){
+                if(__internal_decompress_stream_block(stream, stream->block, stream->needed) == false) return false;
+                stream->stage = DECOMPRESS_STAGE_BLOCK_HEADER;
+                stream->needed = 4;
+            }
+            continue;
+        }
+
+        size_t taken = stream->needed - stream->header_size;
+        if(taken > size) taken = size;
+
+        memcpy(stream->header + stream->header_size, p, taken);
+        stream->header_size += taken;
+        stream->stats.compressed_size += taken;
+        p += taken;
+        size -= taken;
+
+        if(stream->header_size == stream->needed && __internal_decompress_advance(stream) == false) return false;
+    }
+
+    return true;
+}
+
+bool decompress_stream_end(Decompress_Stream* stream, Compress_Stats* stats){
+    if(stream == NULL) return false;
+
+    bool result = stream->failed == false;
+
+    if(result && stream->stage != DECOMPRESS_STAGE_DONE){
+        result = __internal_decompress_fail(stream, "Compressed frame is truncated");
+    }
+
+    if(result && (stream->flags & COMPRESS_FRAME_FLAG_CONTENT_SIZE) &&
+       __internal_compress_load_le64(stream->header + 8) != stream->stats.uncompressed_size){
+        result = __internal_decompress_fail(stream, "Compressed frame is corrupted");
+    }
+
+    if(result) __internal_compress_set_stats(stats, stream->stats.uncompressed_size, stream->stats.compressed_size);
+
+    free(stream->block);
+    free(stream->output);
+    stream->block = NULL;
+    stream->output = NULL;
+
+    return result;
+}
+
+#ifdef __linux__
+static bool __internal_compress_write_fd(void* user_data, const void* data, size_t size){
+    int fd = *(int*)user_data;
+    const char* p = (const char*)data;
+
+    while(size > 0){
+        ssize_t written = write(fd, p, size);
+        if(written < 0){
+            if(errno == EINTR) continue;
+            return false;
+        }
+        p += written;
+        size -= (size_t)written;
+    }
+
+    return true;
+}
+
+bool compress_file(const char* source, const char* destination, const Compress_Options* options, Compress_Stats* stats){
+    File_Reader reader;
+    if(file_reader_open(&reader, source, FILE_READER_DEFAULT_BUFFER_SIZE) == false) return false;
+    file_reader_set_read_ahead(&reader, COMPRESS_MAX_BLOCK_SIZE);
+
+    int fd = open(destination, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if(fd < 0){
+        fprintf(stderr, "[ERROR] Could not open: %s\n", strerror(errno));
+        file_reader_close(&reader);
+        return false;
+    }
+
+    Compress_Stream stream;
+    bool result = compress_stream_init(&stream, __internal_compress_write_fd, &fd, options);
+
+    if(result){
+        String_View chunk;
+        while(result && file_reader_next_chunk(&reader, &chunk)){
+            result = compress_stream_write(&stream, chunk.string, chunk.size);
+        }
+
+        if(file_reader_failed(&reader)) result = false;
+        if(compress_stream_end(&stream, stats) == false) result = false;
+    }
+
+    file_reader_close(&reader);
+    if(close(fd) < 0) result = false;
+
+    //A failed run would leave a frame whose checksum vouches for a truncated input
+    if(result == false) unlink(destination);
+
+    return result;
+}
+
+bool decompress_file(const char* source, const char* destination, Compress_Stats* stats){
+    File_Reader reader;
+    if(file_reader_open(&reader, source, FILE_READER_DEFAULT_BUFFER_SIZE) == false) return false;
+    file_reader_set_read_ahead(&reader, COMPRESS_MAX_BLOCK_SIZE);
+
+    int fd = open(destination, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if(fd < 0){
+        fprintf(stderr, "[ERROR] Could not open: %s\n", strerror(errno));
+        file_reader_close(&reader);
+        return false;
+    }
+
+    Decompress_Stream stream;
+    decompress_stream_init(&stream, __internal_compress_write_fd, &fd);
+
+    bool result = true;
+    String_View chunk;
+    while(result && file_reader_next_chunk(&reader, &chunk)){
+        result = decompress_stream_write(&stream, chunk.string, chunk.size);
+    }
+
+    if(file_reader_failed(&reader)) result = false;
+    if(decompress_stream_end(&stream, stats) == false) result = false;
+
+    file_reader_close(&reader);
+    if(close(fd) < 0) result = false;
+
+    if(result == false) unlink(destination);
+
+    return result;
+}
+#endif
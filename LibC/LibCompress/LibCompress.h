@@ -0,0 +1,124 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "../LibHash/LibHash.h"
+#include "../LibMath/LibMath.h"
+
+//Blocks use the LZ4 block format, so any LZ4 block decoder can read them.
+//Frame layout, integers little endian:
+//  magic (4) | flags (1) | block size code (1) | [content size (8)]
+//  blocks: header (4) + data, header bit 31 set = stored uncompressed, low 31 bits = data size
+//  end mark: header 0 | [XXH64 of the content, seed 0 (8)]
+#define COMPRESS_FRAME_MAGIC 0x1A5A434Cu
+#define COMPRESS_FRAME_FLAG_CHECKSUM 0x01
+#define COMPRESS_FRAME_FLAG_CONTENT_SIZE 0x02
+#define COMPRESS_BLOCK_STORED 0x80000000u
+
+//Block size is 64 KiB << code, from 64 KiB up to 4 MiB
+#define COMPRESS_MIN_BLOCK_SIZE (64 * 1024)
+#define COMPRESS_MAX_BLOCK_SIZE (4 * 1024 * 1024)
+#define COMPRESS_DEFAULT_BLOCK_SIZE (1024 * 1024)
+
+typedef struct
+{
+    size_t block_size;
+    bool checksum;
+}Compress_Options;
+
+typedef struct
+{
+    uint64_t uncompressed_size;
+    uint64_t compressed_size;
+    float ratio;
+    float space_saving;
+}Compress_Stats;
+
+//Receives the produced bytes in order, returning false aborts the stream
+typedef bool (*Compress_Write_Callback)(void* user_data, const void* data, size_t size);
+
+typedef struct
+{
+    Compress_Write_Callback write;
+    void* user_data;
+    size_t block_size;
+    bool checksum;
+    uint8_t* input;
+    size_t input_size;
+    uint8_t* output;
+    Hash_Xxh64 hash;
+    Compress_Stats stats;
+    bool failed;
+}Compress_Stream;
+
+typedef struct
+{
+    Compress_Write_Callback write;
+    void* user_data;
+    int stage;
+    uint8_t flags;
+    size_t block_size;
+    uint8_t header[16];
+    size_t header_size;
+    size_t needed;
+    uint32_t block_header;
+    uint8_t* block;
+    size_t block_filled;
+    uint8_t* output;
+    Hash_Xxh64 hash;
+    Compress_Stats stats;
+    bool failed;
+}Decompress_Stream;
+
+size_t compress_block_bound(size_t size);
+//Returns the compressed size, 0 when it does not fit in capacity
+size_t compress_block(const void* source, size_t size, void* destination, size_t capacity);
+//Rejects malformed input without reading or writing outside the two buffers
+bool decompress_block(const void* source, size_t size, void* destination, size_t capacity, size_t* decompressed_size);
+
+//NULL options select COMPRESS_DEFAULT_BLOCK_SIZE with a checksum.
+//The result is allocated with malloc, stats may be NULL.
+size_t compress_frame_bound(size_t size, const Compress_Options* options);
+bool compress_buffer(const void* source, size_t size, void** destination, size_t* destination_size, const Compress_Options* options, Compress_Stats* stats);
+bool decompress_buffer(const void* source, size_t size, void** destination, size_t* destination_size, Compress_Stats* stats);
+
+bool compress_stream_init(Compress_Stream* stream, Compress_Write_Callback write, void* user_data, const Compress_Options* options);
+bool compress_stream_write(Compress_Stream* stream, const void* data, size_t size);
+//Flushes the last block and the end mark, then releases the stream
+bool compress_stream_end(Compress_Stream* stream, Compress_Stats* stats);
+
+bool decompress_stream_init(Decompress_Stream* stream, Compress_Write_Callback write, void* user_data);
+bool decompress_stream_write(Decompress_Stream* stream, const void* data, size_t size);
+//Fails when the frame was truncated or the checksum does not match, then releases the stream
+bool decompress_stream_end(Decompress_Stream* stream, Compress_Stats* stats);
+
+#ifdef __linux__
+bool compress_file(const char* source, const char* destination, const Compress_Options* options, Compress_Stats* stats);
+bool decompress_file(const char* source, const char* destination, Compress_Stats* stats);
+#endif
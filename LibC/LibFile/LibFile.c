@@ -22,8 +22,23 @@
  * SOFTWARE.
 */
 
+#ifdef __linux__
+    //fallocate, copy_file_range
+    #define _GNU_SOURCE
+#endif
+
 #include "LibFile.h"
 
+#ifdef __linux__
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <sys/uio.h>
+    #include <sys/sendfile.h>
+    #include <limits.h>
+#endif
+
 long get_filesize(FILE* file){
     is_file_open(file);
 
@@ -62,20 +77,36 @@ bool is_file_open(FILE* file_to_open){
     return true;
 }
 
-char* read_buffer_file(const char* file, size_t nelem){
+static char* __internal_file_alloc(Arena* arena, size_t size){
+    if(arena == NULL) return (char*)calloc(size + 1, sizeof(char));
+
+    char* buffer = (char*)arena_alloc_aligned(arena, size + 1, 1);
+    if(buffer != NULL) buffer[size] = '\0';
+
+    return buffer;
+}
+
+static void __internal_file_release(Arena* arena, char* buffer){
+    //Arena memory goes away with the arena
+    if(arena == NULL) free(buffer);
+}
+
+char* read_buffer_file_arena(Arena* arena, const char* file, size_t nelem){
     FILE* fp = fopen(file, "rb");
     
     if(is_file_open(fp) == false) return NULL;
 
-    char* internal_buffer = (char*)calloc(nelem + 1, sizeof(char));
+    char* internal_buffer = __internal_file_alloc(arena, nelem);
     if(internal_buffer == NULL){
         fprintf(stderr, "[ERROR] Could not allocate memory\n");
+        fclose(fp);
         return NULL;
     }
 
     if(!fread(internal_buffer, nelem, 1, fp)){
         fprintf(stderr, "[ERROR] Could not read file:%s\n", file);
-        free(internal_buffer);
+        __internal_file_release(arena, internal_buffer);
+        fclose(fp);
         return NULL;
     }
 
@@ -84,22 +115,29 @@ char* read_buffer_file(const char* file, size_t nelem){
     return internal_buffer;
 }
 
-char* read_entire_file(const char* file){
+char* read_entire_file_arena(Arena* arena, const char* file){
     FILE* fp = fopen(file, "rb");
     
     if(is_file_open(fp) == false) return NULL;
 
-    size_t filesize = get_filesize(fp);
+    long filesize = get_filesize(fp);
+    if(filesize < 0){
+        fprintf(stderr, "[ERROR] Could not get size of file:%s\n", file);
+        fclose(fp);
+        return NULL;
+    }
 
-    char* internal_buffer = (char*)calloc(filesize + 1, sizeof(char));
+    char* internal_buffer = __internal_file_alloc(arena, (size_t)filesize);
     if(internal_buffer == NULL){
         fprintf(stderr, "[ERROR] Could not allocate memory\n");
+        fclose(fp);
         return NULL;
     }
 
-    if(!fread(internal_buffer, filesize, 1, fp)){
+    if(!fread(internal_buffer, (size_t)filesize, 1, fp)){
         fprintf(stderr, "[ERROR] Could not read file:%s\n", file);
-        free(internal_buffer);
+        __internal_file_release(arena, internal_buffer);
+        fclose(fp);
         return NULL;
     }
 
@@ -108,6 +146,14 @@ char* read_entire_file(const char* file){
     return internal_buffer;
 }
 
+char* read_buffer_file(const char* file, size_t nelem){
+    return read_buffer_file_arena(NULL, file, nelem);
+}
+
+char* read_entire_file(const char* file){
+    return read_entire_file_arena(NULL, file);
+}
+
 bool write_entire_file(const char* file, void* data, size_t size){
     FILE* fp = fopen(file, "wb");
 
@@ -133,19 +179,650 @@ bool write_entire_file(const char* file, void* data, size_t size){
     return true;
 }
 
+//Zero-initialized storage goes to .bss, so the chunk costs nothing in the binary
+static char __internal_zero_chunk[FILE_ZERO_CHUNK_SIZE];
+
 bool write_zero_file(const char* file, size_t size){
-    void* zero_file = calloc(size, sizeof(void*));
-    
-    if(zero_file == NULL){
+#ifdef __linux__
+    return create_sparse_file(file, size);
+
+#else
+    FILE* fp = fopen(file, "wb");
+
+    if(is_file_open(fp) == false) return false;
+
+    while(size > 0){
+        size_t chunk = size < FILE_ZERO_CHUNK_SIZE ? size : FILE_ZERO_CHUNK_SIZE;
+
+        if(!fwrite(__internal_zero_chunk, chunk, 1, fp)){
+            fprintf(stderr, "[ERROR] Could not write file:%s\n", file);
+            fclose(fp);
+            return false;
+        }
+        size -= chunk;
+    }
+
+    fclose(fp);
+    return true;
+
+#endif
+}
+
+#ifdef __linux__
+bool map_file(Mapped_File* mapped_file, const char* file, bool writable){
+    if(mapped_file == NULL){
+        fprintf(stderr, "[ERROR] map_file(NULL, %s, %d) mapped_file is NULL\n", file, writable);
+        return false;
+    }
+
+    mapped_file->data = NULL;
+    mapped_file->size = 0;
+    mapped_file->fd = -1;
+    mapped_file->writable = writable;
+
+    int fd = open(file, writable ? O_RDWR : O_RDONLY);
+    if(fd < 0){
+        fprintf(stderr, "[ERROR] Could not open: %s\n", strerror(errno));
+        return false;
+    }
+
+    struct stat file_stat;
+    if(fstat(fd, &file_stat) < 0){
+        fprintf(stderr, "[ERROR] Could not stat file:%s %s\n", file, strerror(errno));
+        close(fd);
+        return false;
+    }
+
+    //mmap refuses zero-length mappings, an empty file is a valid empty view
+    if(file_stat.st_size == 0){
+        mapped_file->fd = fd;
+        return true;
+    }
+
+    int protection = writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+    void* data = mmap(NULL, (size_t)file_stat.st_size, protection, MAP_SHARED, fd, 0);
+    if(data == MAP_FAILED){
+        fprintf(stderr, "[ERROR] Could not map file:%s %s\n", file, strerror(errno));
+        close(fd);
+        return false;
+    }
+
+    mapped_file->data = data;
+    mapped_file->size = (size_t)file_stat.st_size;
+    mapped_file->fd = fd;
+
+    return true;
+}
+
+bool advise_mapped_file(Mapped_File* mapped_file, File_Advice advice){
+    if(mapped_file == NULL) return false;
+    if(mapped_file->data == NULL) return true;
+
+    int madvice = MADV_NORMAL;
+    switch(advice){
+        case FILE_ADVICE_NORMAL:     madvice = MADV_NORMAL;     break;
+        case FILE_ADVICE_SEQUENTIAL: madvice = MADV_SEQUENTIAL; break;
+        case FILE_ADVICE_RANDOM:     madvice = MADV_RANDOM;     break;
+        case FILE_ADVICE_WILLNEED:   madvice = MADV_WILLNEED;   break;
+        case FILE_ADVICE_DONTNEED:   madvice = MADV_DONTNEED;   break;
+        default:
+            fprintf(stderr, "[ERROR] advise_mapped_file unknown advice: %d\n", (int)advice);
+            return false;
+    }
+
+    if(madvise(mapped_file->data, mapped_file->size, madvice) < 0){
+        fprintf(stderr, "[ERROR] Could not advise mapping: %s\n", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+bool sync_mapped_file(Mapped_File* mapped_file){
+    if(mapped_file == NULL) return false;
+    if(mapped_file->data == NULL || mapped_file->writable == false) return true;
+
+    if(msync(mapped_file->data, mapped_file->size, MS_SYNC) < 0){
+        fprintf(stderr, "[ERROR] Could not sync mapping: %s\n", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+void unmap_file(Mapped_File* mapped_file){
+    if(mapped_file == NULL) return;
+
+    if(mapped_file->data != NULL){
+        munmap(mapped_file->data, mapped_file->size);
+    }
+
+    if(mapped_file->fd >= 0){
+        close(mapped_file->fd);
+    }
+
+    mapped_file->data = NULL;
+    mapped_file->size = 0;
+    mapped_file->fd = -1;
+}
+
+String_View mapped_file_to_sv(Mapped_File mapped_file){
+    String_View sv = {0};
+
+    if(mapped_file.data == NULL){
+        sv.string = "";
+        sv.size = 0;
+        return sv;
+    }
+
+    sv.string = (const char*)mapped_file.data;
+    sv.size = mapped_file.size;
+
+    return sv;
+}
+
+bool file_reader_open(File_Reader* reader, const char* file, size_t buffer_size){
+    if(reader == NULL){
+        fprintf(stderr, "[ERROR] file_reader_open(NULL, %s, %zu) reader is NULL\n", file, buffer_size);
+        return false;
+    }
+
+    memset(reader, 0, sizeof(*reader));
+    reader->fd = -1;
+
+    if(buffer_size == 0) buffer_size = FILE_READER_DEFAULT_BUFFER_SIZE;
+
+    int fd = open(file, O_RDONLY);
+    if(fd < 0){
+        fprintf(stderr, "[ERROR] Could not open: %s\n", strerror(errno));
+        return false;
+    }
+
+    reader->buffer = (char*)malloc(buffer_size);
+    if(reader->buffer == NULL){
+        fprintf(stderr, "[ERROR] Could not allocate memory\n");
+        close(fd);
+        return false;
+    }
+
+    reader->fd = fd;
+    reader->capacity = buffer_size;
+    reader->read_ahead = buffer_size;
+
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    return true;
+}
+
+void file_reader_set_read_ahead(File_Reader* reader, size_t read_ahead){
+    if(reader == NULL) return;
+    reader->read_ahead = read_ahead;
+}
+
+static bool __internal_file_reader_fill(File_Reader* reader){
+    if(reader->eof) return false;
+
+    //Keep the unconsumed tail at the front so a partial line can be completed
+    if(reader->start > 0){
+        memmove(reader->buffer, reader->buffer + reader->start, reader->end - reader->start);
+        reader->end -= reader->start;
+        reader->start = 0;
+    }
+
+    if(reader->end == reader->capacity) return false;
+
+    ssize_t bytes_read;
+    do{
+        bytes_read = read(reader->fd, reader->buffer + reader->end, reader->capacity - reader->end);
+    }while(bytes_read < 0 && errno == EINTR);
+
+    if(bytes_read < 0){
+        fprintf(stderr, "[ERROR] Could not read file: %s\n", strerror(errno));
+        reader->eof = true;
+        reader->error = true;
+        return false;
+    }
+
+    if(bytes_read == 0){
+        reader->eof = true;
+        return false;
+    }
+
+    reader->end += (size_t)bytes_read;
+    reader->offset += bytes_read;
+
+    if(reader->read_ahead > 0){
+        posix_fadvise(reader->fd, (off_t)reader->offset, (off_t)reader->read_ahead, POSIX_FADV_WILLNEED);
+    }
+
+    return true;
+}
+
+bool file_reader_next_chunk(File_Reader* reader, String_View* chunk){
+    if(reader == NULL || chunk == NULL) return false;
+
+    if(reader->start == reader->end){
+        reader->start = 0;
+        reader->end = 0;
+        if(__internal_file_reader_fill(reader) == false) return false;
+    }
+
+    chunk->string = reader->buffer + reader->start;
+    chunk->size = reader->end - reader->start;
+    reader->start = reader->end;
+
+    return true;
+}
+
+bool file_reader_next_line(File_Reader* reader, String_View* line){
+    if(reader == NULL || line == NULL) return false;
+
+    size_t scanned = reader->start;
+
+    for(;;){
+        size_t available = reader->end - scanned;
+        char* newline = (char*)memchr(reader->buffer + scanned, '\n', available);
+
+        if(newline != NULL){
+            line->string = reader->buffer + reader->start;
+            line->size = (size_t)(newline - line->string);
+            reader->start = (size_t)(newline - reader->buffer) + 1;
+            reader->partial_line = false;
+            return true;
+        }
+
+        size_t consumed = reader->start;
+        if(__internal_file_reader_fill(reader) == false) break;
+        scanned = scanned - consumed + available;
+    }
+
+    if(reader->start == reader->end) return false;
+
+    //Either the last line has no terminator or it does not fit the buffer:
+    //hand out what is buffered so memory stays bounded by the buffer size
+    line->string = reader->buffer + reader->start;
+    line->size = reader->end - reader->start;
+    reader->start = reader->end;
+    reader->partial_line = (reader->eof == false);
+
+    return true;
+}
+
+bool file_reader_failed(const File_Reader* reader){
+    return reader != NULL && reader->error;
+}
+
+void file_reader_close(File_Reader* reader){
+    if(reader == NULL) return;
+
+    if(reader->fd >= 0){
+        close(reader->fd);
+    }
+    free(reader->buffer);
+
+    memset(reader, 0, sizeof(*reader));
+    reader->fd = -1;
+}
+
+static bool __internal_file_write_zeros(int fd, off_t offset, off_t length){
+    while(length > 0){
+        size_t chunk = length < FILE_ZERO_CHUNK_SIZE ? (size_t)length : FILE_ZERO_CHUNK_SIZE;
+
+        ssize_t written = pwrite(fd, __internal_zero_chunk, chunk, offset);
+        if(written < 0){
+            if(errno == EINTR) continue;
+            return false;
+        }
+
+        offset += written;
+        length -= written;
+    }
+
+    return true;
+}
+
+//The filesystem does not implement the requested fallocate mode
+static inline bool __internal_fallocate_unsupported(int error){
+    return error == EOPNOTSUPP || error == ENOSYS || error == EINVAL;
+}
+
+bool create_sparse_file(const char* file, size_t size){
+    if((off_t)size < 0){
+        fprintf(stderr, "[ERROR] create_sparse_file(%s, %zu) size is too large\n", file, size);
+        return false;
+    }
+
+    int fd = open(file, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if(fd < 0){
+        fprintf(stderr, "[ERROR] Could not open: %s\n", strerror(errno));
+        return false;
+    }
+
+    if(ftruncate(fd, (off_t)size) < 0){
+        //Filesystems without sparse files (some FUSE and network mounts) still accept writes
+        if(__internal_file_write_zeros(fd, 0, (off_t)size) == false){
+            fprintf(stderr, "[ERROR] Could not write file:%s %s\n", file, strerror(errno));
+            close(fd);
+            return false;
+        }
+    }
+
+    close(fd);
+    return true;
+}
+
+bool preallocate_file(const char* file, size_t size){
+    if((off_t)size < 0){
+        fprintf(stderr, "[ERROR] preallocate_file(%s, %zu) size is too large\n", file, size);
+        return false;
+    }
+
+    int fd = open(file, O_WRONLY | O_CREAT, 0666);
+    if(fd < 0){
+        fprintf(stderr, "[ERROR] Could not open: %s\n", strerror(errno));
+        return false;
+    }
+
+    if(size == 0 || fallocate(fd, 0, 0, (off_t)size) == 0){
+        close(fd);
+        return true;
+    }
+
+    if(__internal_fallocate_unsupported(errno) == false){
+        fprintf(stderr, "[ERROR] Could not preallocate file:%s %s\n", file, strerror(errno));
+        close(fd);
+        return false;
+    }
+
+    //Only the part past the current end can be reserved by writing without clobbering data
+    struct stat file_stat;
+    if(fstat(fd, &file_stat) < 0){
+        fprintf(stderr, "[ERROR] Could not stat file:%s %s\n", file, strerror(errno));
+        close(fd);
+        return false;
+    }
+
+    if(file_stat.st_size < (off_t)size &&
+       __internal_file_write_zeros(fd, file_stat.st_size, (off_t)size - file_stat.st_size) == false){
+        fprintf(stderr, "[ERROR] Could not write file:%s %s\n", file, strerror(errno));
+        close(fd);
+        return false;
+    }
+
+    close(fd);
+    return true;
+}
+
+bool punch_hole_file(const char* file, size_t offset, size_t length){
+    if((off_t)offset < 0 || (off_t)length < 0){
+        fprintf(stderr, "[ERROR] punch_hole_file(%s, %zu, %zu) range is too large\n", file, offset, length);
+        return false;
+    }
+
+    int fd = open(file, O_WRONLY);
+    if(fd < 0){
+        fprintf(stderr, "[ERROR] Could not open: %s\n", strerror(errno));
+        return false;
+    }
+
+    if(length == 0 || fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, (off_t)offset, (off_t)length) == 0){
+        close(fd);
+        return true;
+    }
+
+    if(__internal_fallocate_unsupported(errno) == false){
+        fprintf(stderr, "[ERROR] Could not punch hole in file:%s %s\n", file, strerror(errno));
+        close(fd);
+        return false;
+    }
+
+    //Without hole punching the range still has to read back as zeros
+    if(fallocate(fd, FALLOC_FL_ZERO_RANGE | FALLOC_FL_KEEP_SIZE, (off_t)offset, (off_t)length) == 0){
+        close(fd);
+        return true;
+    }
+
+    struct stat file_stat;
+    if(fstat(fd, &file_stat) < 0){
+        fprintf(stderr, "[ERROR] Could not stat file:%s %s\n", file, strerror(errno));
+        close(fd);
+        return false;
+    }
+
+    //KEEP_SIZE semantics: nothing past the end of the file is touched
+    off_t end = (off_t)offset + (off_t)length;
+    if(end > file_stat.st_size) end = file_stat.st_size;
+
+    if((off_t)offset < end && __internal_file_write_zeros(fd, (off_t)offset, end - (off_t)offset) == false){
+        fprintf(stderr, "[ERROR] Could not write file:%s %s\n", file, strerror(errno));
+        close(fd);
+        return false;
+    }
+
+    close(fd);
+    return true;
+}
+//Writes a whole batch, resuming after partial writes
+static bool __internal_file_writev(int fd, struct iovec* iov, int count){
+    while(count > 0){
+        ssize_t written = writev(fd, iov, count);
+        if(written < 0){
+            if(errno == EINTR) continue;
+            return false;
+        }
+
+        while(count > 0 && (size_t)written >= iov->iov_len){
+            written -= (ssize_t)iov->iov_len;
+            iov++;
+            count--;
+        }
+
+        if(count > 0){
+            iov->iov_base = (char*)iov->iov_base + written;
+            iov->iov_len -= (size_t)written;
+        }
+    }
+
+    return true;
+}
+
+static int __internal_file_create(const char* file){
+    int fd = open(file, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if(fd < 0){
+        fprintf(stderr, "[ERROR] Could not open: %s\n", strerror(errno));
+    }
+
+    return fd;
+}
+
+bool write_buffers_file(const char* file, const File_Buffer* buffers, size_t count){
+    if(buffers == NULL && count > 0){
+        fprintf(stderr, "[ERROR] write_buffers_file(%s, NULL, %zu) buffers is NULL\n", file, count);
+        return false;
+    }
+
+    int fd = __internal_file_create(file);
+    if(fd < 0) return false;
+
+    struct iovec iov[IOV_MAX];
+    size_t index = 0;
+
+    while(index < count){
+        int batch = 0;
+        for(; index < count && batch < IOV_MAX; index++){
+            if(buffers[index].size == 0) continue;
+
+            iov[batch].iov_base = (void*)buffers[index].data;
+            iov[batch].iov_len = buffers[index].size;
+            batch++;
+        }
+
+        if(__internal_file_writev(fd, iov, batch) == false){
+            fprintf(stderr, "[ERROR] Could not write file:%s %s\n", file, strerror(errno));
+            close(fd);
+            return false;
+        }
+    }
+
+    close(fd);
+    return true;
+}
+
+bool write_views_file(const char* file, const String_View* views, size_t count){
+    if(views == NULL && count > 0){
+        fprintf(stderr, "[ERROR] write_views_file(%s, NULL, %zu) views is NULL\n", file, count);
+        return false;
+    }
+
+    int fd = __internal_file_create(file);
+    if(fd < 0) return false;
+
+    struct iovec iov[IOV_MAX];
+    size_t index = 0;
+
+    while(index < count){
+        int batch = 0;
+        for(; index < count && batch < IOV_MAX; index++){
+            if(views[index].size == 0) continue;
+
+            iov[batch].iov_base = (void*)views[index].string;
+            iov[batch].iov_len = views[index].size;
+            batch++;
+        }
+
+        if(__internal_file_writev(fd, iov, batch) == false){
+            fprintf(stderr, "[ERROR] Could not write file:%s %s\n", file, strerror(errno));
+            close(fd);
+            return false;
+        }
+    }
+
+    close(fd);
+    return true;
+}
+
+//Errors meaning "this pair of files cannot be copied this way", not a real I/O failure
+static inline bool __internal_copy_unsupported(int error){
+    return error == ENOSYS || error == EXDEV || error == EINVAL || error == EOPNOTSUPP || error == EBADF;
+}
+
+static bool __internal_copy_read_write(int in, int out){
+    char* buffer = (char*)malloc(FILE_COPY_BUFFER_SIZE);
+    if(buffer == NULL){
         fprintf(stderr, "[ERROR] Could not allocate memory\n");
         return false;
     }
 
-    if(write_entire_file(file, zero_file, size) == false){
-        free(zero_file);
+    for(;;){
+        ssize_t bytes_read = read(in, buffer, FILE_COPY_BUFFER_SIZE);
+        if(bytes_read < 0){
+            if(errno == EINTR) continue;
+            free(buffer);
+            return false;
+        }
+        if(bytes_read == 0) break;
+
+        char* p = buffer;
+        while(bytes_read > 0){
+            ssize_t written = write(out, p, (size_t)bytes_read);
+            if(written < 0){
+                if(errno == EINTR) continue;
+                free(buffer);
+                return false;
+            }
+            p += written;
+            bytes_read -= written;
+        }
+    }
+
+    free(buffer);
+    return true;
+}
+
+//Returns 1 when the copy is complete, 0 when this method cannot copy between the two files
+//and -1 on an I/O error. Both calls advance the file offsets, so the next method picks up
+//where the previous one stopped.
+static int __internal_copy_in_kernel(int in, int out, bool use_sendfile, off_t source_size){
+    bool copied = false;
+
+    for(;;){
+        ssize_t result = use_sendfile ? sendfile(out, in, NULL, SSIZE_MAX)
+                                      : copy_file_range(in, NULL, out, NULL, SSIZE_MAX, 0);
+        if(result > 0){
+            copied = true;
+            continue;
+        }
+
+        //Pseudo files report size 0 and copy nothing, let read() find out what they hold
+        if(result == 0) return copied || source_size > 0 ? 1 : 0;
+
+        if(errno == EINTR) continue;
+        return __internal_copy_unsupported(errno) ? 0 : -1;
+    }
+}
+
+bool copy_file(const char* source, const char* destination){
+    int in = open(source, O_RDONLY);
+    if(in < 0){
+        fprintf(stderr, "[ERROR] Could not open: %s\n", strerror(errno));
+        return false;
+    }
+
+    struct stat file_stat;
+    if(fstat(in, &file_stat) < 0){
+        fprintf(stderr, "[ERROR] Could not stat file:%s %s\n", source, strerror(errno));
+        close(in);
+        return false;
+    }
+
+    //Truncated only once it is known not to be the source, a copy onto itself (or onto a hard link
+    //of it) would otherwise empty the source and report success
+    int out = open(destination, O_WRONLY | O_CREAT, file_stat.st_mode & 0777);
+    if(out < 0){
+        fprintf(stderr, "[ERROR] Could not open: %s\n", strerror(errno));
+        close(in);
+        return false;
+    }
+
+    struct stat destination_stat;
+    if(fstat(out, &destination_stat) < 0){
+        fprintf(stderr, "[ERROR] Could not stat file:%s %s\n", destination, strerror(errno));
+        close(in);
+        close(out);
+        return false;
+    }
+
+    if(destination_stat.st_dev == file_stat.st_dev && destination_stat.st_ino == file_stat.st_ino){
+        fprintf(stderr, "[ERROR] Could not copy %s to %s: they are the same file\n", source, destination);
+        close(in);
+        close(out);
+        return false;
+    }
+
+    if(ftruncate(out, 0) < 0){
+        fprintf(stderr, "[ERROR] Could not truncate file:%s %s\n", destination, strerror(errno));
+        close(in);
+        close(out);
+        return false;
+    }
+
+    int result = __internal_copy_in_kernel(in, out, false, file_stat.st_size);
+    if(result == 0) result = __internal_copy_in_kernel(in, out, true, file_stat.st_size);
+    if(result == 0) result = __internal_copy_read_write(in, out) ? 1 : -1;
+
+    close(in);
+
+    if(result < 0){
+        fprintf(stderr, "[ERROR] Could not copy %s to %s: %s\n", source, destination, strerror(errno));
+        close(out);
+        return false;
+    }
+
+    if(close(out) < 0){
+        fprintf(stderr, "[ERROR] Could not write file:%s %s\n", destination, strerror(errno));
         return false;
     }
 
-    free(zero_file);
     return true;
 }
+#endif
\ No newline at end of file
@@ -31,6 +31,51 @@
 #include <stdint.h>
 #include <errno.h>
 
+#include "../LibString/LibStringView.h"
+
+typedef enum {
+    FILE_ADVICE_NORMAL = 0,
+    FILE_ADVICE_SEQUENTIAL,
+    FILE_ADVICE_RANDOM,
+    FILE_ADVICE_WILLNEED,
+    FILE_ADVICE_DONTNEED
+}File_Advice;
+
+typedef struct
+{
+    void* data;
+    size_t size;
+    int fd;
+    bool writable;
+}Mapped_File;
+
+#define FILE_READER_DEFAULT_BUFFER_SIZE (64 * 1024)
+//Zeros are written in chunks of this size when a filesystem cannot allocate them itself
+#define FILE_ZERO_CHUNK_SIZE (64 * 1024)
+//Buffer used by copy_file when the kernel cannot copy between the two files itself
+#define FILE_COPY_BUFFER_SIZE (128 * 1024)
+
+typedef struct
+{
+    const void* data;
+    size_t size;
+}File_Buffer;
+
+typedef struct
+{
+    int fd;
+    char* buffer;
+    size_t capacity;
+    size_t start;
+    size_t end;
+    long long offset;
+    size_t read_ahead;
+    bool eof;
+    //Set with eof when a read fails, so iteration stops the same way as at the end of the file
+    bool error;
+    bool partial_line;
+}File_Reader;
+
 long get_filesize(FILE* file);
 long get_filesize_from_file(const char* file);
 bool is_file_open(FILE* file_to_open);
@@ -38,9 +83,103 @@ bool is_file_open(FILE* file_to_open);
 char* read_buffer_file(const char* file, size_t nelem);
 char* read_entire_file(const char* file);
 
+//Same as above but the result lives in arena (NULL arena falls back to calloc) and must not be freed
+char* read_buffer_file_arena(Arena* arena, const char* file, size_t nelem);
+char* read_entire_file_arena(Arena* arena, const char* file);
+
 bool write_entire_file(const char* file, void* data, size_t size);
+//Creates a file that reads as size zero bytes, sparse where the platform allows it
 bool write_zero_file(const char* file, size_t size);
 
+#ifdef __linux__
+bool map_file(Mapped_File* mapped_file, const char* file, bool writable);
+bool advise_mapped_file(Mapped_File* mapped_file, File_Advice advice);
+bool sync_mapped_file(Mapped_File* mapped_file);
+void unmap_file(Mapped_File* mapped_file);
+String_View mapped_file_to_sv(Mapped_File mapped_file);
+
+//Views returned by file_reader_next_* point into the reader buffer and stay valid until the next call.
+//Lines longer than the buffer are returned in pieces with partial_line set on every piece but the last.
+bool file_reader_open(File_Reader* reader, const char* file, size_t buffer_size);
+void file_reader_set_read_ahead(File_Reader* reader, size_t read_ahead);
+bool file_reader_next_chunk(File_Reader* reader, String_View* chunk);
+bool file_reader_next_line(File_Reader* reader, String_View* line);
+//True when iteration ended on a read error rather than at the end of the file
+bool file_reader_failed(const File_Reader* reader);
+void file_reader_close(File_Reader* reader);
+
+//Sets the size without allocating blocks, they are allocated on the first write
+bool create_sparse_file(const char* file, size_t size);
+//Reserves blocks up to size, creating or growing the file, so later writes cannot fail with ENOSPC
+bool preallocate_file(const char* file, size_t size);
+//Releases the blocks of a range without changing the file size, the range reads back as zeros
+bool punch_hole_file(const char* file, size_t offset, size_t length);
+
+//Write the pieces in order with writev, without joining them in memory first
+bool write_buffers_file(const char* file, const File_Buffer* buffers, size_t count);
+bool write_views_file(const char* file, const String_View* views, size_t count);
+//Copies inside the kernel (copy_file_range, then sendfile), with a read/write loop as last resort
+bool copy_file(const char* source, const char* destination);
+#endif
+
+typedef enum {
+    FILE_TYPE_UNKNOWN = 0,
+    FILE_TYPE_ELF,
+    FILE_TYPE_PE,
+    FILE_TYPE_MACHO,
+    FILE_TYPE_JAVA_CLASS,
+    FILE_TYPE_DEX,
+    FILE_TYPE_WASM,
+    FILE_TYPE_LUA_BYTECODE,
+    FILE_TYPE_SCRIPT,
+    FILE_TYPE_PNG,
+    FILE_TYPE_JPG,
+    FILE_TYPE_GIF,
+    FILE_TYPE_BMP,
+    FILE_TYPE_TIFF,
+    FILE_TYPE_ICO,
+    FILE_TYPE_PSD,
+    FILE_TYPE_WEBP,
+    FILE_TYPE_PDF,
+    FILE_TYPE_POSTSCRIPT,
+    FILE_TYPE_RTF,
+    FILE_TYPE_XML,
+    FILE_TYPE_OLE,
+    FILE_TYPE_SQLITE,
+    FILE_TYPE_WAV,
+    FILE_TYPE_AVI,
+    FILE_TYPE_MP3,
+    FILE_TYPE_FLAC,
+    FILE_TYPE_OGG,
+    FILE_TYPE_MIDI,
+    FILE_TYPE_MKV,
+    FILE_TYPE_MP4,
+    FILE_TYPE_ZIP,
+    FILE_TYPE_RAR,
+    FILE_TYPE_7Z,
+    FILE_TYPE_GZIP,
+    FILE_TYPE_BZIP2,
+    FILE_TYPE_XZ,
+    FILE_TYPE_ZSTD,
+    FILE_TYPE_LZ4,
+    FILE_TYPE_TAR,
+    FILE_TYPE_CAB,
+    FILE_TYPE_AR,
+    FILE_TYPE_RPM,
+    FILE_TYPE_TTF,
+    FILE_TYPE_OTF,
+    FILE_TYPE_WOFF,
+    FILE_TYPE_WOFF2,
+    FILE_TYPE_COUNT
+}File_Type;
+
+//Bytes read from the start of a file to classify it, large enough for the tar header at offset 257
+#define FILE_TYPE_HEADER_SIZE 512
+
+File_Type detect_file_type(const char* file);
+File_Type detect_buffer_type(const void* buffer, size_t size);
+const char* file_type_name(File_Type type);
+
 bool is_file_elf(const char* file);
 bool is_file_png(const char* file);
 bool is_file_pdf(const char* file);
@@ -48,140 +187,199 @@ bool is_file_jpg(const char* file);
 
 #ifdef CHECK_FILE_TYPE_IMPLEMENTATION
 
-bool is_file_elf(const char* file){
-    const uint8_t elf_magic_number[4] = { 0x7F, 0x45, 0x4C, 0x46};
-    
-    char* buffer_elf_file = read_buffer_file(file, 4);
-
-    if(buffer_elf_file == NULL){
-        fprintf(stderr, "[ERROR] Buffer is NULL\n");
-        fprintf(stderr, "[ERROR] Could not identify file\n");
-        return false;
-    }
+//Wildcard for a magic number byte that can hold any value (the "??" of the signature list)
+#define FILE_SIGNATURE_ANY 0x100
+#define FILE_SIGNATURE_MAX_SIZE 16
+
+typedef struct
+{
+    File_Type type;
+    uint16_t offset;
+    uint8_t size;
+    uint16_t magic[FILE_SIGNATURE_MAX_SIZE];
+}File_Signature;
+
+#define ANY FILE_SIGNATURE_ANY
+//Longer and more specific signatures come first, the first match wins
+static const File_Signature file_signatures[] = {
+    {FILE_TYPE_SQLITE,       0,   16, {0x53, 0x51, 0x4C, 0x69, 0x74, 0x65, 0x20, 0x66, 0x6F, 0x72, 0x6D, 0x61, 0x74, 0x20, 0x33, 0x00}},
+    {FILE_TYPE_JPG,          0,   12, {0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 0x4A, 0x46, 0x49, 0x46, 0x00, 0x01}},
+    {FILE_TYPE_JPG,          0,   12, {0xFF, 0xD8, 0xFF, 0xE1, ANY,  ANY,  0x45, 0x78, 0x69, 0x66, 0x00, 0x00}},
+    {FILE_TYPE_WEBP,         0,   12, {0x52, 0x49, 0x46, 0x46, ANY,  ANY,  ANY,  ANY,  0x57, 0x45, 0x42, 0x50}},
+    {FILE_TYPE_WAV,          0,   12, {0x52, 0x49, 0x46, 0x46, ANY,  ANY,  ANY,  ANY,  0x57, 0x41, 0x56, 0x45}},
+    {FILE_TYPE_AVI,          0,   12, {0x52, 0x49, 0x46, 0x46, ANY,  ANY,  ANY,  ANY,  0x41, 0x56, 0x49, 0x20}},
+    {FILE_TYPE_PNG,          0,    8, {0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A}},
+    {FILE_TYPE_PNG,          0,    8, {0x50, 0x89, 0x47, 0x4E, 0x0A, 0x0D, 0x0A, 0x1A}},
+    {FILE_TYPE_OLE,          0,    8, {0xD0, 0xCF, 0x11, 0xE0, 0xA1, 0xB1, 0x1A, 0xE1}},
+    {FILE_TYPE_DEX,          0,    8, {0x64, 0x65, 0x78, 0x0A, 0x30, 0x33, 0x35, 0x00}},
+    {FILE_TYPE_AR,           0,    8, {0x21, 0x3C, 0x61, 0x72, 0x63, 0x68, 0x3E, 0x0A}},
+    {FILE_TYPE_RAR,          0,    8, {0x52, 0x61, 0x72, 0x21, 0x1A, 0x07, 0x01, 0x00}},
+    {FILE_TYPE_MP4,          4,    4, {0x66, 0x74, 0x79, 0x70}},
+    {FILE_TYPE_RAR,          0,    7, {0x52, 0x61, 0x72, 0x21, 0x1A, 0x07, 0x00}},
+    {FILE_TYPE_GIF,          0,    6, {0x47, 0x49, 0x46, 0x38, 0x37, 0x61}},
+    {FILE_TYPE_GIF,          0,    6, {0x47, 0x49, 0x46, 0x38, 0x39, 0x61}},
+    {FILE_TYPE_7Z,           0,    6, {0x37, 0x7A, 0xBC, 0xAF, 0x27, 0x1C}},
+    {FILE_TYPE_XZ,           0,    6, {0xFD, 0x37, 0x7A, 0x58, 0x5A, 0x00}},
+    {FILE_TYPE_XML,          0,    6, {0x3C, 0x3F, 0x78, 0x6D, 0x6C, 0x20}},
+    {FILE_TYPE_RTF,          0,    6, {0x7B, 0x5C, 0x72, 0x74, 0x66, 0x31}},
+    {FILE_TYPE_TAR,        257,    5, {0x75, 0x73, 0x74, 0x61, 0x72}},
+    {FILE_TYPE_PDF,          0,    5, {0x25, 0x50, 0x44, 0x46, 0x2D}},
+    {FILE_TYPE_TTF,          0,    5, {0x00, 0x01, 0x00, 0x00, 0x00}},
+    {FILE_TYPE_ELF,          0,    4, {0x7F, 0x45, 0x4C, 0x46}},
+    {FILE_TYPE_JPG,          0,    4, {0xFF, 0xD8, 0xFF, 0xDB}},
+    {FILE_TYPE_JPG,          0,    4, {0xFF, 0xD8, 0xFF, 0xEE}},
+    {FILE_TYPE_JPG,          0,    4, {0xFF, 0xD8, 0xFF, 0xE0}},
+    {FILE_TYPE_JAVA_CLASS,   0,    4, {0xCA, 0xFE, 0xBA, 0xBE}},
+    {FILE_TYPE_MACHO,        0,    4, {0xFE, 0xED, 0xFA, 0xCE}},
+    {FILE_TYPE_MACHO,        0,    4, {0xFE, 0xED, 0xFA, 0xCF}},
+    {FILE_TYPE_MACHO,        0,    4, {0xCE, 0xFA, 0xED, 0xFE}},
+    {FILE_TYPE_MACHO,        0,    4, {0xCF, 0xFA, 0xED, 0xFE}},
+    {FILE_TYPE_WASM,         0,    4, {0x00, 0x61, 0x73, 0x6D}},
+    {FILE_TYPE_LUA_BYTECODE, 0,    4, {0x1B, 0x4C, 0x75, 0x61}},
+    {FILE_TYPE_TIFF,         0,    4, {0x49, 0x49, 0x2A, 0x00}},
+    {FILE_TYPE_TIFF,         0,    4, {0x4D, 0x4D, 0x00, 0x2A}},
+    {FILE_TYPE_ICO,          0,    4, {0x00, 0x00, 0x01, 0x00}},
+    {FILE_TYPE_PSD,          0,    4, {0x38, 0x42, 0x50, 0x53}},
+    {FILE_TYPE_POSTSCRIPT,   0,    4, {0x25, 0x21, 0x50, 0x53}},
+    {FILE_TYPE_FLAC,         0,    4, {0x66, 0x4C, 0x61, 0x43}},
+    {FILE_TYPE_OGG,          0,    4, {0x4F, 0x67, 0x67, 0x53}},
+    {FILE_TYPE_MIDI,         0,    4, {0x4D, 0x54, 0x68, 0x64}},
+    {FILE_TYPE_MKV,          0,    4, {0x1A, 0x45, 0xDF, 0xA3}},
+    {FILE_TYPE_ZIP,          0,    4, {0x50, 0x4B, 0x03, 0x04}},
+    {FILE_TYPE_ZIP,          0,    4, {0x50, 0x4B, 0x05, 0x06}},
+    {FILE_TYPE_ZIP,          0,    4, {0x50, 0x4B, 0x07, 0x08}},
+    {FILE_TYPE_ZSTD,         0,    4, {0x28, 0xB5, 0x2F, 0xFD}},
+    {FILE_TYPE_LZ4,          0,    4, {0x04, 0x22, 0x4D, 0x18}},
+    {FILE_TYPE_CAB,          0,    4, {0x4D, 0x53, 0x43, 0x46}},
+    {FILE_TYPE_RPM,          0,    4, {0xED, 0xAB, 0xEE, 0xDB}},
+    {FILE_TYPE_OTF,          0,    4, {0x4F, 0x54, 0x54, 0x4F}},
+    {FILE_TYPE_WOFF,         0,    4, {0x77, 0x4F, 0x46, 0x46}},
+    {FILE_TYPE_WOFF2,        0,    4, {0x77, 0x4F, 0x46, 0x32}},
+    {FILE_TYPE_MP3,          0,    3, {0x49, 0x44, 0x33}},
+    {FILE_TYPE_BZIP2,        0,    3, {0x42, 0x5A, 0x68}},
+    {FILE_TYPE_MP3,          0,    2, {0xFF, 0xFB}},
+    {FILE_TYPE_MP3,          0,    2, {0xFF, 0xF3}},
+    {FILE_TYPE_MP3,          0,    2, {0xFF, 0xF2}},
+    {FILE_TYPE_GZIP,         0,    2, {0x1F, 0x8B}},
+    {FILE_TYPE_SCRIPT,       0,    2, {0x23, 0x21}},
+    {FILE_TYPE_PE,           0,    2, {0x4D, 0x5A}},
+    {FILE_TYPE_BMP,          0,    2, {0x42, 0x4D}},
+};
+#undef ANY
+
+static const char* file_type_names[FILE_TYPE_COUNT] = {
+    [FILE_TYPE_UNKNOWN]      = "unknown",
+    [FILE_TYPE_ELF]          = "elf",
+    [FILE_TYPE_PE]           = "pe",
+    [FILE_TYPE_MACHO]        = "mach-o",
+    [FILE_TYPE_JAVA_CLASS]   = "java-class",
+    [FILE_TYPE_DEX]          = "dex",
+    [FILE_TYPE_WASM]         = "wasm",
+    [FILE_TYPE_LUA_BYTECODE] = "lua-bytecode",
+    [FILE_TYPE_SCRIPT]       = "script",
+    [FILE_TYPE_PNG]          = "png",
+    [FILE_TYPE_JPG]          = "jpg",
+    [FILE_TYPE_GIF]          = "gif",
+    [FILE_TYPE_BMP]          = "bmp",
+    [FILE_TYPE_TIFF]         = "tiff",
+    [FILE_TYPE_ICO]          = "ico",
+    [FILE_TYPE_PSD]          = "psd",
+    [FILE_TYPE_WEBP]         = "webp",
+    [FILE_TYPE_PDF]          = "pdf",
+    [FILE_TYPE_POSTSCRIPT]   = "postscript",
+    [FILE_TYPE_RTF]          = "rtf",
+    [FILE_TYPE_XML]          = "xml",
+    [FILE_TYPE_OLE]          = "ole",
+    [FILE_TYPE_SQLITE]       = "sqlite",
+    [FILE_TYPE_WAV]          = "wav",
+    [FILE_TYPE_AVI]          = "avi",
+    [FILE_TYPE_MP3]          = "mp3",
+    [FILE_TYPE_FLAC]         = "flac",
+    [FILE_TYPE_OGG]          = "ogg",
+    [FILE_TYPE_MIDI]         = "midi",
+    [FILE_TYPE_MKV]          = "mkv",
+    [FILE_TYPE_MP4]          = "mp4",
+    [FILE_TYPE_ZIP]          = "zip",
+    [FILE_TYPE_RAR]          = "rar",
+    [FILE_TYPE_7Z]           = "7z",
+    [FILE_TYPE_GZIP]         = "gzip",
+    [FILE_TYPE_BZIP2]        = "bzip2",
+    [FILE_TYPE_XZ]           = "xz",
+    [FILE_TYPE_ZSTD]         = "zstd",
+    [FILE_TYPE_LZ4]          = "lz4",
+    [FILE_TYPE_TAR]          = "tar",
+    [FILE_TYPE_CAB]          = "cab",
+    [FILE_TYPE_AR]           = "ar",
+    [FILE_TYPE_RPM]          = "rpm",
+    [FILE_TYPE_TTF]          = "ttf",
+    [FILE_TYPE_OTF]          = "otf",
+    [FILE_TYPE_WOFF]         = "woff",
+    [FILE_TYPE_WOFF2]        = "woff2",
+};
+
+File_Type detect_buffer_type(const void* buffer, size_t size){
+    if(buffer == NULL) return FILE_TYPE_UNKNOWN;
+
+    const uint8_t* header = (const uint8_t*)buffer;
+
+    for(size_t i = 0; i < sizeof(file_signatures) / sizeof(file_signatures[0]); i++){
+        const File_Signature* signature = &file_signatures[i];
+
+        if((size_t)signature->offset + signature->size > size) continue;
+
+        const uint8_t* bytes = header + signature->offset;
+        bool match = true;
+
+        for(uint8_t j = 0; j < signature->size; j++){
+            if(signature->magic[j] == FILE_SIGNATURE_ANY) continue;
+            if(bytes[j] != signature->magic[j]){
+                match = false;
+                break;
+            }
+        }
 
-    if(memcmp(buffer_elf_file, elf_magic_number, 4) == 0){
-        free(buffer_elf_file);
-        return true;
+        if(match) return signature->type;
     }
 
-    free(buffer_elf_file);
-    return false;
+    return FILE_TYPE_UNKNOWN;
 }
 
-bool is_file_png(const char* file){
-    const uint8_t png_magic_number[8]         = {0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A};
-    const uint8_t png_magic_number_variant[8] = {0x50, 0x89, 0x47, 0x4E, 0x0A, 0x0D, 0x0A, 0x1A};
-
-    char* buffer_png_file = read_buffer_file(file, 8);
-    
-    if(buffer_png_file == NULL){
-        fprintf(stderr, "[ERROR] Buffer is NULL\n");
-        fprintf(stderr, "[ERROR] Could not identify file\n");
-        return false;
-    }
+File_Type detect_file_type(const char* file){
+    uint8_t header[FILE_TYPE_HEADER_SIZE];
 
-    if(memcmp(buffer_png_file, png_magic_number, 8) == 0){
-        free(buffer_png_file);
-        return true;
-    }
+    FILE* fp = fopen(file, "rb");
+    if(is_file_open(fp) == false) return FILE_TYPE_UNKNOWN;
 
-    if(memcmp(buffer_png_file, png_magic_number_variant, 8) == 0){
-        free(buffer_png_file);
-        return true;
+    size_t header_size = fread(header, 1, sizeof(header), fp);
+    if(header_size == 0 && ferror(fp)){
+        fprintf(stderr, "[ERROR] Could not read file:%s\n", file);
+        fclose(fp);
+        return FILE_TYPE_UNKNOWN;
     }
 
-    free(buffer_png_file);
-    return false;
-}
+    fclose(fp);
 
-bool is_file_pdf(const char* file){
-    const uint8_t pdf_magic_number[5] = {0x25, 0x50, 0x44, 0x46, 0x2D};
+    return detect_buffer_type(header, header_size);
+}
 
-    char* buffer_pdf_file = read_buffer_file(file, 5);
+const char* file_type_name(File_Type type){
+    if((int)type < 0 || type >= FILE_TYPE_COUNT) return file_type_names[FILE_TYPE_UNKNOWN];
+    return file_type_names[type];
+}
 
-    if(buffer_pdf_file == NULL){
-        fprintf(stderr, "[ERROR] Buffer is NULL\n");
-        fprintf(stderr, "[ERROR] Could not identify file\n");
-        return false;
-    }
+bool is_file_elf(const char* file){
+    return detect_file_type(file) == FILE_TYPE_ELF;
+}
 
-    if(memcmp(buffer_pdf_file, pdf_magic_number, 5) == 0){
-        free(buffer_pdf_file);
-        return true;
-    }
+bool is_file_png(const char* file){
+    return detect_file_type(file) == FILE_TYPE_PNG;
+}
 
-    free(buffer_pdf_file);
-    return false;
+bool is_file_pdf(const char* file){
+    return detect_file_type(file) == FILE_TYPE_PDF;
 }
 
 bool is_file_jpg(const char* file){
-    const uint8_t jpg_magic_number[12] = {0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 0x4A, 0x46, 0x49, 0x46, 0x00, 0x01};
-    
-    char* buffer_jpg_file = read_buffer_file(file, 12);
-
-    if(buffer_jpg_file == NULL){
-        fprintf(stderr, "[ERROR] Buffer is NULL\n");
-        fprintf(stderr, "[ERROR] Could not identify file\n");
-        return false;
-    }
-
-    if(memcmp(buffer_jpg_file, jpg_magic_number, 12) == 0){
-        free(buffer_jpg_file);
-        return true;
-    }
-    free(buffer_jpg_file);
-    
-    const uint8_t jpg_magic_number_variant[4]   = {0xFF, 0xD8, 0xFF, 0xEE};
-    char* buffer_jpg_file_2 = read_buffer_file(file, 4);
-    
-    if(buffer_jpg_file_2 == NULL){
-        fprintf(stderr, "[ERROR] Buffer is NULL\n");
-        fprintf(stderr, "[ERROR] Could not identify file\n");
-        return false;
-    }
-
-    if(memcmp(buffer_jpg_file_2, jpg_magic_number_variant, 4) == 0){
-        free(buffer_jpg_file_2);
-        return true;
-    }
-    free(buffer_jpg_file_2);
-
-
-    const uint8_t jpg_magic_number_variant2[4]  = {0xFF, 0xD8, 0xFF, 0xE0};
-    char* buffer_jpg_file_3 = read_buffer_file(file, 4);
-
-    if(buffer_jpg_file_3 == NULL){
-        fprintf(stderr, "[ERROR] Buffer is NULL\n");
-        fprintf(stderr, "[ERROR] Could not identify file\n");
-        return false;
-    }
-
-    if(memcmp(buffer_jpg_file_3, jpg_magic_number_variant2, 4) == 0){
-        free(buffer_jpg_file_3);
-        return true;
-    }
-    free(buffer_jpg_file_3);
-
-
-    const uint8_t jpg_magic_number_variant3[12] = {0xFF, 0xD8, 0xFF, 0xE1, 0x3F, 0x3F, 0x45, 0x78, 0x69, 0x66, 0x00, 0x00};//0x3F == ? skippable
-    char* buffer_jpg_file_4 = read_buffer_file(file, 12);
-
-    if(buffer_jpg_file_4 == NULL){
-        fprintf(stderr, "[ERROR] Buffer is NULL\n");
-        fprintf(stderr, "[ERROR] Could not identify file\n");
-        return false;
-    }
-
-    for(int i = 0; i < 12; i++){
-        if(buffer_jpg_file_4[i] == 0x3F){
-            i++;
-        }
-        if(memcmp(&buffer_jpg_file_4[i], &jpg_magic_number_variant3[i], 1) != 0){
-            return false;
-        }
-    }
-    free(buffer_jpg_file_4);
-    return true;
-
+    return detect_file_type(file) == FILE_TYPE_JPG;
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,702 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#ifdef __linux__
+    //pread/pwrite, syscall, O_CLOEXEC and MAP_POPULATE under -std=c11
+    #define _GNU_SOURCE
+#endif
+
+#include "LibFileAsync.h"
+
+#ifdef __linux__
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <pthread.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <sys/uio.h>
+    #include <sys/syscall.h>
+
+#if defined(__has_include)
+    #if __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup)
+        #include <linux/io_uring.h>
+        #define LIB_FILE_HAS_URING
+    #endif
+#endif
+
+//Largest single read or write issued, the kernel caps a single transfer just below 2GB anyway
+#define ASYNC_FILE_MAX_TRANSFER (1u << 30)
+
+//The fallback pool only has to keep the disk busy, a deep ring must not turn into thousands of threads
+#define ASYNC_FILE_MAX_THREADS 64
+
+typedef struct Async_File_Request
+{
+    Async_File_Op op;
+    //Opened when the request is issued, so only in-flight requests hold a descriptor
+    char* path;
+    int fd;
+    char* buffer;
+    size_t size;
+    size_t done;
+    int error;
+    void* user_data;
+    struct iovec iov;
+    struct Async_File_Request* next;
+}Async_File_Request;
+
+typedef struct
+{
+    Async_File_Request* head;
+    Async_File_Request* tail;
+}Async_File_List;
+
+typedef struct
+{
+    Async_File_List pending;
+    Async_File_List completed;
+    size_t outstanding;
+    size_t issued;
+
+    //Thread pool backend
+    pthread_mutex_t lock;
+    pthread_cond_t pending_cond;
+    pthread_cond_t completed_cond;
+    pthread_t* threads;
+    size_t thread_count;
+    bool stopping;
+
+#ifdef LIB_FILE_HAS_URING
+    int ring_fd;
+    void* sq_ring;
+    void* cq_ring;
+    size_t sq_ring_size;
+    size_t cq_ring_size;
+    struct io_uring_sqe* sqes;
+    size_t sqes_size;
+    unsigned* sq_head;
+    unsigned* sq_tail;
+    unsigned* sq_mask;
+    unsigned* sq_array;
+    unsigned* cq_head;
+    unsigned* cq_tail;
+    unsigned* cq_mask;
+    struct io_uring_cqe* cqes;
+    unsigned to_submit;
+#endif
+}Async_File_State;
+
+static void __internal_async_list_push(Async_File_List* list, Async_File_Request* request){
+    request->next = NULL;
+    if(list->tail != NULL) list->tail->next = request;
+    else list->head = request;
+    list->tail = request;
+}
+
+static Async_File_Request* __internal_async_list_pop(Async_File_List* list){
+    Async_File_Request* request = list->head;
+    if(request == NULL) return NULL;
+
+    list->head = request->next;
+    if(list->head == NULL) list->tail = NULL;
+    request->next = NULL;
+
+    return request;
+}
+
+//Called once the transfer is over, completed requests waiting for the caller hold no descriptor
+static void __internal_async_close(Async_File_Request* request){
+    if(request->fd >= 0) close(request->fd);
+    request->fd = -1;
+}
+
+static void __internal_async_free(Async_File_Request* request){
+    __internal_async_close(request);
+    free(request->path);
+    free(request);
+}
+
+//Opens the file of a request about to be issued, READ_ENTIRE also sizes its buffer here.
+//Returns false with request->error set when the request cannot be issued.
+static bool __internal_async_open(Async_File_Request* request){
+    if(request->fd >= 0) return true;
+
+    int flags = (request->op == ASYNC_FILE_WRITE_ENTIRE) ? (O_WRONLY | O_CREAT | O_TRUNC) : O_RDONLY;
+    request->fd = open(request->path, flags | O_CLOEXEC, 0666);
+    if(request->fd < 0){
+        request->error = errno;
+        return false;
+    }
+
+    if(request->op != ASYNC_FILE_READ_ENTIRE) return true;
+
+    struct stat file_stat;
+    if(fstat(request->fd, &file_stat) < 0){
+        request->error = errno;
+        return false;
+    }
+
+    request->size = (size_t)file_stat.st_size;
+    request->buffer = (char*)calloc(request->size + 1, sizeof(char));
+    if(request->buffer == NULL){
+        request->error = ENOMEM;
+        return false;
+    }
+
+    return true;
+}
+
+static void __internal_async_finish(Async_File_Request* request, Async_File_Result* result){
+    result->op = request->op;
+    result->user_data = request->user_data;
+    result->error = request->error;
+    result->success = (request->error == 0);
+    result->data = NULL;
+    result->size = request->done;
+
+    if(request->op != ASYNC_FILE_WRITE_ENTIRE){
+        if(result->success){
+            result->data = request->buffer;
+        }
+        else{
+            free(request->buffer);
+        }
+    }
+
+    __internal_async_free(request);
+}
+
+//Advances a request by one transfer result, returns true once it needs no further I/O
+static bool __internal_async_advance(Async_File_Request* request, long long transferred){
+    if(transferred < 0){
+        if(transferred == -EINTR || transferred == -EAGAIN) return false;
+        request->error = (int)-transferred;
+        return true;
+    }
+
+    if(transferred == 0 && request->done < request->size){
+        //The file got shorter (read) or the device is full (write)
+        request->error = (request->op == ASYNC_FILE_WRITE_ENTIRE) ? ENOSPC : EIO;
+        return true;
+    }
+
+    request->done += (size_t)transferred;
+    return request->done >= request->size;
+}
+
+static void __internal_async_prepare_iov(Async_File_Request* request){
+    size_t remaining = request->size - request->done;
+    if(remaining > ASYNC_FILE_MAX_TRANSFER) remaining = ASYNC_FILE_MAX_TRANSFER;
+
+    request->iov.iov_base = request->buffer + request->done;
+    request->iov.iov_len = remaining;
+}
+
+///
+///io_uring backend
+///
+
+#ifdef LIB_FILE_HAS_URING
+static bool __internal_uring_setup(Async_File_State* state, unsigned queue_depth){
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+
+    int ring_fd = (int)syscall(__NR_io_uring_setup, queue_depth, &params);
+    if(ring_fd < 0) return false;
+
+    state->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    state->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+
+    bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if(single_mmap){
+        if(state->cq_ring_size > state->sq_ring_size) state->sq_ring_size = state->cq_ring_size;
+        state->cq_ring_size = state->sq_ring_size;
+    }
+
+    state->sq_ring = mmap(NULL, state->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+    if(state->sq_ring == MAP_FAILED){
+        close(ring_fd);
+        return false;
+    }
+
+    if(single_mmap){
+        state->cq_ring = state->sq_ring;
+    }
+    else{
+        state->cq_ring = mmap(NULL, state->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+        if(state->cq_ring == MAP_FAILED){
+            munmap(state->sq_ring, state->sq_ring_size);
+            close(ring_fd);
+            return false;
+        }
+    }
+
+    state->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    state->sqes = (struct io_uring_sqe*)mmap(NULL, state->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES);
+    if(state->sqes == MAP_FAILED){
+        if(state->cq_ring != state->sq_ring) munmap(state->cq_ring, state->cq_ring_size);
+        munmap(state->sq_ring, state->sq_ring_size);
+        close(ring_fd);
+        return false;
+    }
+
+    char* sq = (char*)state->sq_ring;
+    char* cq = (char*)state->cq_ring;
+
+    state->sq_head  = (unsigned*)(sq + params.sq_off.head);
+    state->sq_tail  = (unsigned*)(sq + params.sq_off.tail);
+    state->sq_mask  = (unsigned*)(sq + params.sq_off.ring_mask);
+    state->sq_array = (unsigned*)(sq + params.sq_off.array);
+    state->cq_head  = (unsigned*)(cq + params.cq_off.head);
+    state->cq_tail  = (unsigned*)(cq + params.cq_off.tail);
+    state->cq_mask  = (unsigned*)(cq + params.cq_off.ring_mask);
+    state->cqes     = (struct io_uring_cqe*)(cq + params.cq_off.cqes);
+
+    state->ring_fd = ring_fd;
+    state->to_submit = 0;
+
+    return true;
+}
+
+static void __internal_uring_teardown(Async_File_State* state){
+    munmap(state->sqes, state->sqes_size);
+    if(state->cq_ring != state->sq_ring) munmap(state->cq_ring, state->cq_ring_size);
+    munmap(state->sq_ring, state->sq_ring_size);
+    close(state->ring_fd);
+}
+
+//Moves pending requests into free submission slots, bounded by the queue depth
+static void __internal_uring_queue(Async_File_State* state, unsigned queue_depth){
+    while(state->issued < queue_depth && state->pending.head != NULL){
+        Async_File_Request* request = __internal_async_list_pop(&state->pending);
+
+        //Failed opens and empty files complete without reaching the ring
+        if(__internal_async_open(request) == false || request->size == 0){
+            __internal_async_close(request);
+            __internal_async_list_push(&state->completed, request);
+            continue;
+        }
+
+        unsigned tail = *state->sq_tail;
+        unsigned index = tail & *state->sq_mask;
+        struct io_uring_sqe* sqe = &state->sqes[index];
+
+        __internal_async_prepare_iov(request);
+
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = (request->op == ASYNC_FILE_WRITE_ENTIRE) ? IORING_OP_WRITEV : IORING_OP_READV;
+        sqe->fd = request->fd;
+        sqe->off = request->done;
+        sqe->addr = (unsigned long long)(uintptr_t)&request->iov;
+        sqe->len = 1;
+        sqe->user_data = (unsigned long long)(uintptr_t)request;
+
+        state->sq_array[index] = index;
+        __atomic_store_n(state->sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+        state->to_submit++;
+        state->issued++;
+    }
+}
+
+static bool __internal_uring_enter(Async_File_State* state, unsigned min_complete){
+    unsigned flags = min_complete > 0 ? IORING_ENTER_GETEVENTS : 0;
+
+    for(;;){
+        int submitted = (int)syscall(__NR_io_uring_enter, state->ring_fd, state->to_submit, min_complete, flags, NULL, 0);
+        if(submitted >= 0){
+            state->to_submit -= (unsigned)submitted;
+            return true;
+        }
+        if(errno == EINTR) continue;
+
+        fprintf(stderr, "[ERROR] io_uring_enter failed: %s\n", strerror(errno));
+        return false;
+    }
+}
+
+static void __internal_uring_reap(Async_File_State* state){
+    unsigned head = *state->cq_head;
+    unsigned tail = __atomic_load_n(state->cq_tail, __ATOMIC_ACQUIRE);
+
+    while(head != tail){
+        struct io_uring_cqe* cqe = &state->cqes[head & *state->cq_mask];
+        Async_File_Request* request = (Async_File_Request*)(uintptr_t)cqe->user_data;
+
+        state->issued--;
+
+        if(__internal_async_advance(request, cqe->res)){
+            __internal_async_close(request);
+            __internal_async_list_push(&state->completed, request);
+        }
+        else{
+            __internal_async_list_push(&state->pending, request);
+        }
+
+        head++;
+    }
+
+    __atomic_store_n(state->cq_head, head, __ATOMIC_RELEASE);
+}
+#endif
+
+///
+///Thread pool backend
+///
+
+static void* __internal_async_worker(void* arg){
+    Async_File_State* state = (Async_File_State*)arg;
+
+    for(;;){
+        pthread_mutex_lock(&state->lock);
+        while(state->pending.head == NULL && state->stopping == false){
+            pthread_cond_wait(&state->pending_cond, &state->lock);
+        }
+
+        Async_File_Request* request = __internal_async_list_pop(&state->pending);
+        pthread_mutex_unlock(&state->lock);
+
+        if(request == NULL) break;
+
+        bool finished = (__internal_async_open(request) == false || request->size == 0);
+        while(finished == false){
+            __internal_async_prepare_iov(request);
+
+            ssize_t transferred;
+            if(request->op == ASYNC_FILE_WRITE_ENTIRE){
+                transferred = pwrite(request->fd, request->iov.iov_base, request->iov.iov_len, (off_t)request->done);
+            }
+            else{
+                transferred = pread(request->fd, request->iov.iov_base, request->iov.iov_len, (off_t)request->done);
+            }
+
+            finished = __internal_async_advance(request, transferred < 0 ? -(long long)errno : (long long)transferred);
+        }
+        __internal_async_close(request);
+
+        pthread_mutex_lock(&state->lock);
+        __internal_async_list_push(&state->completed, request);
+        pthread_cond_signal(&state->completed_cond);
+        pthread_mutex_unlock(&state->lock);
+    }
+
+    return NULL;
+}
+
+static bool __internal_threads_setup(Async_File_State* state, unsigned queue_depth){
+    state->thread_count = queue_depth < ASYNC_FILE_MAX_THREADS ? queue_depth : ASYNC_FILE_MAX_THREADS;
+    state->threads = (pthread_t*)calloc(state->thread_count, sizeof(pthread_t));
+    if(state->threads == NULL) return false;
+
+    size_t started = 0;
+    for(; started < state->thread_count; started++){
+        if(pthread_create(&state->threads[started], NULL, __internal_async_worker, state) != 0) break;
+    }
+
+    state->thread_count = started;
+    if(started == 0){
+        free(state->threads);
+        state->threads = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+///
+///Public API
+///
+
+bool async_file_io_init(Async_File_IO* io, unsigned queue_depth, Async_File_Backend backend){
+    if(io == NULL){
+        fprintf(stderr, "[ERROR] async_file_io_init(NULL, %u, %d) io is NULL\n", queue_depth, (int)backend);
+        return false;
+    }
+
+    if(queue_depth == 0) queue_depth = ASYNC_FILE_DEFAULT_QUEUE_DEPTH;
+
+    Async_File_State* state = (Async_File_State*)calloc(1, sizeof(Async_File_State));
+    if(state == NULL){
+        fprintf(stderr, "[ERROR] Could not allocate memory\n");
+        return false;
+    }
+
+    pthread_mutex_init(&state->lock, NULL);
+    pthread_cond_init(&state->pending_cond, NULL);
+    pthread_cond_init(&state->completed_cond, NULL);
+
+    //Set before any failure path below, async_file_io_destroy tears down by backend
+    io->queue_depth = queue_depth;
+    io->backend = ASYNC_FILE_BACKEND_THREADS;
+    io->internal = state;
+
+#ifdef LIB_FILE_HAS_URING
+    if(backend != ASYNC_FILE_BACKEND_THREADS){
+        if(__internal_uring_setup(state, queue_depth)){
+            io->backend = ASYNC_FILE_BACKEND_URING;
+            return true;
+        }
+        if(backend == ASYNC_FILE_BACKEND_URING){
+            fprintf(stderr, "[ERROR] io_uring is not available: %s\n", strerror(errno));
+            async_file_io_destroy(io);
+            return false;
+        }
+    }
+#else
+    if(backend == ASYNC_FILE_BACKEND_URING){
+        fprintf(stderr, "[ERROR] io_uring support was not compiled in\n");
+        async_file_io_destroy(io);
+        return false;
+    }
+#endif
+
+    if(__internal_threads_setup(state, queue_depth) == false){
+        fprintf(stderr, "[ERROR] Could not start the async file I/O threads\n");
+        async_file_io_destroy(io);
+        return false;
+    }
+
+    io->backend = ASYNC_FILE_BACKEND_THREADS;
+    return true;
+}
+
+void async_file_io_destroy(Async_File_IO* io){
+    if(io == NULL || io->internal == NULL) return;
+
+    Async_File_State* state = (Async_File_State*)io->internal;
+
+    //Drain whatever is still running so no buffer outlives its request
+    Async_File_Result result;
+    while(async_file_io_wait(io, &result)){
+        free(result.data);
+    }
+
+    if(state->threads != NULL){
+        pthread_mutex_lock(&state->lock);
+        state->stopping = true;
+        pthread_cond_broadcast(&state->pending_cond);
+        pthread_mutex_unlock(&state->lock);
+
+        for(size_t i = 0; i < state->thread_count; i++){
+            pthread_join(state->threads[i], NULL);
+        }
+        free(state->threads);
+    }
+
+#ifdef LIB_FILE_HAS_URING
+    if(io->backend == ASYNC_FILE_BACKEND_URING){
+        __internal_uring_teardown(state);
+    }
+#endif
+
+    pthread_mutex_destroy(&state->lock);
+    pthread_cond_destroy(&state->pending_cond);
+    pthread_cond_destroy(&state->completed_cond);
+    free(state);
+
+    io->internal = NULL;
+}
+
+static bool __internal_async_enqueue(Async_File_IO* io, Async_File_Request* request){
+    Async_File_State* state = (Async_File_State*)io->internal;
+
+    //Nothing to transfer, the request completes without touching the backend.
+    //READ_ENTIRE only learns its size when the file is opened.
+    bool immediate = (request->size == 0 && request->op != ASYNC_FILE_READ_ENTIRE);
+
+    if(io->backend == ASYNC_FILE_BACKEND_THREADS){
+        pthread_mutex_lock(&state->lock);
+        if(immediate){
+            __internal_async_list_push(&state->completed, request);
+        }
+        else{
+            __internal_async_list_push(&state->pending, request);
+            pthread_cond_signal(&state->pending_cond);
+        }
+        state->outstanding++;
+        pthread_mutex_unlock(&state->lock);
+        return true;
+    }
+
+    __internal_async_list_push(immediate ? &state->completed : &state->pending, request);
+    state->outstanding++;
+
+    return true;
+}
+
+static Async_File_Request* __internal_async_request(Async_File_IO* io, Async_File_Op op, const char* file, void* user_data){
+    if(io == NULL || io->internal == NULL){
+        fprintf(stderr, "[ERROR] Async file I/O is not initialized\n");
+        return NULL;
+    }
+
+    Async_File_Request* request = (Async_File_Request*)calloc(1, sizeof(Async_File_Request));
+    if(request == NULL){
+        fprintf(stderr, "[ERROR] Could not allocate memory\n");
+        return NULL;
+    }
+
+    request->path = strdup(file);
+    if(request->path == NULL){
+        fprintf(stderr, "[ERROR] Could not allocate memory\n");
+        free(request);
+        return NULL;
+    }
+
+    request->fd = -1;
+    request->op = op;
+    request->user_data = user_data;
+
+    return request;
+}
+
+bool async_read_entire_file(Async_File_IO* io, const char* file, void* user_data){
+    Async_File_Request* request = __internal_async_request(io, ASYNC_FILE_READ_ENTIRE, file, user_data);
+    if(request == NULL) return false;
+
+    return __internal_async_enqueue(io, request);
+}
+
+bool async_read_buffer_file(Async_File_IO* io, const char* file, size_t nelem, void* user_data){
+    Async_File_Request* request = __internal_async_request(io, ASYNC_FILE_READ_BUFFER, file, user_data);
+    if(request == NULL) return false;
+
+    request->size = nelem;
+    request->buffer = (char*)calloc(nelem + 1, sizeof(char));
+    if(request->buffer == NULL){
+        fprintf(stderr, "[ERROR] Could not allocate memory\n");
+        __internal_async_free(request);
+        return false;
+    }
+
+    return __internal_async_enqueue(io, request);
+}
+
+bool async_write_entire_file(Async_File_IO* io, const char* file, const void* data, size_t size, void* user_data){
+    if(data == NULL){
+        fprintf(stderr, "[ERROR] async_write_entire_file(%s, NULL, %zu) data is NULL\n", file, size);
+        return false;
+    }
+
+    if(size == 0){
+        fprintf(stderr, "[WARNING] async_write_entire_file(%s, data, %zu) size is 0\n", file, size);
+    }
+
+    Async_File_Request* request = __internal_async_request(io, ASYNC_FILE_WRITE_ENTIRE, file, user_data);
+    if(request == NULL) return false;
+
+    request->buffer = (char*)data;
+    request->size = size;
+
+    return __internal_async_enqueue(io, request);
+}
+
+bool async_file_io_submit(Async_File_IO* io){
+    if(io == NULL || io->internal == NULL) return false;
+
+#ifdef LIB_FILE_HAS_URING
+    if(io->backend == ASYNC_FILE_BACKEND_URING){
+        Async_File_State* state = (Async_File_State*)io->internal;
+        __internal_uring_queue(state, io->queue_depth);
+        if(state->to_submit == 0) return true;
+        return __internal_uring_enter(state, 0);
+    }
+#endif
+
+    //Worker threads pick requests up as soon as they are queued
+    return true;
+}
+
+static bool __internal_async_take(Async_File_IO* io, Async_File_Result* result, bool block){
+    if(io == NULL || io->internal == NULL || result == NULL) return false;
+
+    Async_File_State* state = (Async_File_State*)io->internal;
+
+    if(io->backend == ASYNC_FILE_BACKEND_THREADS){
+        pthread_mutex_lock(&state->lock);
+        while(block && state->completed.head == NULL && state->outstanding > 0){
+            pthread_cond_wait(&state->completed_cond, &state->lock);
+        }
+
+        Async_File_Request* request = __internal_async_list_pop(&state->completed);
+        if(request != NULL) state->outstanding--;
+        pthread_mutex_unlock(&state->lock);
+
+        if(request == NULL) return false;
+
+        __internal_async_finish(request, result);
+        return true;
+    }
+
+#ifdef LIB_FILE_HAS_URING
+    while(state->completed.head == NULL && state->outstanding > 0){
+        __internal_uring_queue(state, io->queue_depth);
+        __internal_uring_reap(state);
+        if(state->completed.head != NULL) break;
+
+        //Requeued short transfers may have been added back to pending
+        __internal_uring_queue(state, io->queue_depth);
+        if(block == false){
+            if(state->to_submit > 0) __internal_uring_enter(state, 0);
+            __internal_uring_reap(state);
+            break;
+        }
+
+        if(__internal_uring_enter(state, 1) == false) return false;
+        __internal_uring_reap(state);
+    }
+#endif
+
+    Async_File_Request* request = __internal_async_list_pop(&state->completed);
+    if(request == NULL) return false;
+
+    state->outstanding--;
+    __internal_async_finish(request, result);
+
+    return true;
+}
+
+bool async_file_io_wait(Async_File_IO* io, Async_File_Result* result){
+    return __internal_async_take(io, result, true);
+}
+
+bool async_file_io_poll(Async_File_IO* io, Async_File_Result* result){
+    return __internal_async_take(io, result, false);
+}
+
+size_t async_file_io_in_flight(Async_File_IO* io){
+    if(io == NULL || io->internal == NULL) return 0;
+
+    Async_File_State* state = (Async_File_State*)io->internal;
+
+    if(io->backend == ASYNC_FILE_BACKEND_THREADS){
+        pthread_mutex_lock(&state->lock);
+        size_t outstanding = state->outstanding;
+        pthread_mutex_unlock(&state->lock);
+        return outstanding;
+    }
+
+    return state->outstanding;
+}
+#endif
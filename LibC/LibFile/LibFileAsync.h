@@ -0,0 +1,76 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+
+#include "LibFile.h"
+
+typedef enum {
+    ASYNC_FILE_BACKEND_AUTO = 0,
+    ASYNC_FILE_BACKEND_URING,
+    ASYNC_FILE_BACKEND_THREADS
+}Async_File_Backend;
+
+typedef enum {
+    ASYNC_FILE_READ_ENTIRE = 0,
+    ASYNC_FILE_READ_BUFFER,
+    ASYNC_FILE_WRITE_ENTIRE
+}Async_File_Op;
+
+typedef struct
+{
+    Async_File_Op op;
+    void* user_data;
+    bool success;
+    int error;
+    //Read results are NUL terminated and owned by the caller, exactly like read_entire_file
+    char* data;
+    size_t size;
+}Async_File_Result;
+
+//An Async_File_IO must be driven from a single thread
+typedef struct
+{
+    Async_File_Backend backend;
+    unsigned queue_depth;
+    void* internal;
+}Async_File_IO;
+
+#define ASYNC_FILE_DEFAULT_QUEUE_DEPTH 64
+
+#ifdef __linux__
+bool async_file_io_init(Async_File_IO* io, unsigned queue_depth, Async_File_Backend backend);
+void async_file_io_destroy(Async_File_IO* io);
+
+//Files are opened when a request is issued, so open errors arrive in the result's error field
+bool async_read_entire_file(Async_File_IO* io, const char* file, void* user_data);
+bool async_read_buffer_file(Async_File_IO* io, const char* file, size_t nelem, void* user_data);
+//data must stay alive until the matching result has been returned
+bool async_write_entire_file(Async_File_IO* io, const char* file, const void* data, size_t size, void* user_data);
+
+bool async_file_io_submit(Async_File_IO* io);
+bool async_file_io_wait(Async_File_IO* io, Async_File_Result* result);
+bool async_file_io_poll(Async_File_IO* io, Async_File_Result* result);
+size_t async_file_io_in_flight(Async_File_IO* io);
+#endif
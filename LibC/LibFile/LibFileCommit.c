@@ -0,0 +1,277 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#ifdef __linux__
+    //sync_file_range
+    #define _GNU_SOURCE
+#endif
+
+#include "LibFileCommit.h"
+#include "../LibString/LibStringMap.h"
+
+#ifdef __linux__
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <limits.h>
+    #include <stdatomic.h>
+    #include <sys/stat.h>
+
+#define FILE_COMMIT_TEMP_ATTEMPTS 16
+
+static atomic_uint __internal_commit_counter;
+
+//Everything up to the last '/', "." for a bare file name
+static String_View __internal_commit_directory(const char* file){
+    String_View path = sv_from_parts(file, strlen(file));
+    size_t slash = SV_NPOS;
+
+    for(size_t i = path.size; i > 0; i--){
+        if(path.string[i - 1] == '/'){
+            slash = i - 1;
+            break;
+        }
+    }
+
+    if(slash == SV_NPOS) return sv_from_parts(".", 1);
+    if(slash == 0) return sv_from_parts("/", 1);
+
+    return sv_from_parts(file, slash);
+}
+
+static bool __internal_commit_write_all(int fd, const void* data, size_t size){
+    const char* p = (const char*)data;
+
+    while(size > 0){
+        ssize_t written = write(fd, p, size);
+        if(written < 0){
+            if(errno == EINTR) continue;
+            return false;
+        }
+        p += written;
+        size -= (size_t)written;
+    }
+
+    return true;
+}
+
+//Creates a hidden temporary in the directory of file so the final rename stays atomic
+static int __internal_commit_create_temp(const char* file, char** temp_file){
+    size_t size = strlen(file) + 64;
+    char* temp = (char*)malloc(size);
+    if(temp == NULL){
+        fprintf(stderr, "[ERROR] Could not allocate memory\n");
+        return -1;
+    }
+
+    String_View directory = __internal_commit_directory(file);
+    const char* name = strrchr(file, '/');
+    name = name == NULL ? file : name + 1;
+
+    for(int attempt = 0; attempt < FILE_COMMIT_TEMP_ATTEMPTS; attempt++){
+        snprintf(temp, size, "%.*s/.%s.%ld.%u.tmp", (int)directory.size, directory.string, name,
+                 (long)getpid(), atomic_fetch_add_explicit(&__internal_commit_counter, 1, memory_order_relaxed));
+
+        int fd = open(temp, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+        if(fd >= 0){
+            *temp_file = temp;
+            return fd;
+        }
+        if(errno != EEXIST) break;
+    }
+
+    fprintf(stderr, "[ERROR] Could not create temporary file for %s: %s\n", file, strerror(errno));
+    free(temp);
+    return -1;
+}
+
+void file_commit_init(File_Commit* commit){
+    if(commit == NULL) return;
+
+    commit->entries = NULL;
+    commit->count = 0;
+    commit->capacity = 0;
+}
+
+bool file_commit_write(File_Commit* commit, const char* file, const void* data, size_t size){
+    if(commit == NULL || file == NULL) return false;
+
+    if(data == NULL && size > 0){
+        fprintf(stderr, "[ERROR] file_commit_write(%s, NULL, %zu) data is NULL\n", file, size);
+        return false;
+    }
+
+    if(commit->count == commit->capacity){
+        size_t capacity = commit->capacity == 0 ? 8 : commit->capacity * 2;
+        File_Commit_Entry* entries = (File_Commit_Entry*)realloc(commit->entries, capacity * sizeof(File_Commit_Entry));
+        if(entries == NULL){
+            fprintf(stderr, "[ERROR] Could not allocate memory\n");
+            return false;
+        }
+        commit->entries = entries;
+        commit->capacity = capacity;
+    }
+
+    char* target = strdup(file);
+    if(target == NULL){
+        fprintf(stderr, "[ERROR] Could not allocate memory\n");
+        return false;
+    }
+
+    char* temp_file;
+    int fd = __internal_commit_create_temp(file, &temp_file);
+    if(fd < 0){
+        free(target);
+        return false;
+    }
+
+    //The replacement keeps the permissions of the file it replaces
+    struct stat file_stat;
+    if(stat(file, &file_stat) == 0) fchmod(fd, file_stat.st_mode & 07777);
+
+    if(__internal_commit_write_all(fd, data, size) == false){
+        fprintf(stderr, "[ERROR] Could not write file:%s %s\n", temp_file, strerror(errno));
+        close(fd);
+        unlink(temp_file);
+        free(temp_file);
+        free(target);
+        return false;
+    }
+
+    //Start writeback now so the fsync in file_commit_end finds most of the data already on disk
+    sync_file_range(fd, 0, 0, SYNC_FILE_RANGE_WRITE);
+
+    File_Commit_Entry* entry = &commit->entries[commit->count++];
+    entry->file = target;
+    entry->temp_file = temp_file;
+    entry->fd = fd;
+
+    return true;
+}
+
+static void __internal_commit_release(File_Commit* commit, bool remove_temporaries){
+    for(size_t i = 0; i < commit->count; i++){
+        File_Commit_Entry* entry = &commit->entries[i];
+
+        if(entry->fd >= 0) close(entry->fd);
+        if(remove_temporaries) unlink(entry->temp_file);
+
+        free(entry->file);
+        free(entry->temp_file);
+    }
+
+    free(commit->entries);
+    file_commit_init(commit);
+}
+
+void file_commit_abort(File_Commit* commit){
+    if(commit == NULL) return;
+    __internal_commit_release(commit, true);
+}
+
+static bool __internal_commit_sync_directory(String_View directory){
+    char path[PATH_MAX];
+    if(directory.size >= sizeof(path)) return false;
+
+    memcpy(path, directory.string, directory.size);
+    path[directory.size] = '\0';
+
+    int fd = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if(fd < 0){
+        fprintf(stderr, "[ERROR] Could not open: %s\n", strerror(errno));
+        return false;
+    }
+
+    bool synced = fsync(fd) == 0;
+    if(synced == false) fprintf(stderr, "[ERROR] Could not sync directory:%s %s\n", path, strerror(errno));
+
+    close(fd);
+    return synced;
+}
+
+bool file_commit_end(File_Commit* commit){
+    if(commit == NULL) return false;
+
+    for(size_t i = 0; i < commit->count; i++){
+        File_Commit_Entry* entry = &commit->entries[i];
+
+        //The descriptor is closed whether or not the sync worked, either failure aborts the commit
+        bool synced = fsync(entry->fd) == 0;
+        if(synced == false) fprintf(stderr, "[ERROR] Could not sync file:%s %s\n", entry->temp_file, strerror(errno));
+
+        bool closed = close(entry->fd) == 0;
+        if(closed == false) fprintf(stderr, "[ERROR] Could not close file:%s %s\n", entry->temp_file, strerror(errno));
+
+        entry->fd = -1;
+
+        if(synced == false || closed == false){
+            __internal_commit_release(commit, true);
+            return false;
+        }
+    }
+
+    String_Map directories;
+    bool deduplicate = string_map_init(&directories, false);
+    bool result = true;
+
+    for(size_t i = 0; i < commit->count; i++){
+        File_Commit_Entry* entry = &commit->entries[i];
+
+        if(rename(entry->temp_file, entry->file) < 0){
+            fprintf(stderr, "[ERROR] Could not rename %s to %s: %s\n", entry->temp_file, entry->file, strerror(errno));
+            unlink(entry->temp_file);
+            result = false;
+            continue;
+        }
+
+        String_View directory = __internal_commit_directory(entry->file);
+
+        //Directories are synced once at the end, one the map cannot hold is synced right away
+        if(deduplicate == false || string_map_put(&directories, directory, NULL) == false){
+            if(__internal_commit_sync_directory(directory) == false) result = false;
+        }
+    }
+
+    if(deduplicate){
+        size_t iterator = 0;
+        String_Map_Entry* directory;
+
+        while(string_map_next(&directories, &iterator, &directory)){
+            if(__internal_commit_sync_directory(directory->key) == false) result = false;
+        }
+        string_map_free(&directories);
+    }
+
+    __internal_commit_release(commit, false);
+    return result;
+}
+
+bool replace_file(const char* file, const void* data, size_t size){
+    File_Commit commit;
+    file_commit_init(&commit);
+
+    if(file_commit_write(&commit, file, data, size) == false) return false;
+
+    return file_commit_end(&commit);
+}
+#endif
@@ -0,0 +1,55 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+
+#include "LibFile.h"
+
+typedef struct
+{
+    char* file;
+    char* temp_file;
+    int fd;
+}File_Commit_Entry;
+
+//Group commit: every file is written to a temporary next to its target, then file_commit_end
+//syncs the data, renames all of them into place and syncs each directory only once.
+//Each pending file keeps a descriptor open until the commit ends.
+typedef struct
+{
+    File_Commit_Entry* entries;
+    size_t count;
+    size_t capacity;
+}File_Commit;
+
+#ifdef __linux__
+//After a crash the file holds either the old or the new content, never a mix
+bool replace_file(const char* file, const void* data, size_t size);
+
+void file_commit_init(File_Commit* commit);
+bool file_commit_write(File_Commit* commit, const char* file, const void* data, size_t size);
+//Nothing is renamed unless every file reached the disk, the temporaries are removed either way
+bool file_commit_end(File_Commit* commit);
+void file_commit_abort(File_Commit* commit);
+#endif
@@ -0,0 +1,340 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#ifdef __linux__
+    //O_CLOEXEC, DT_* and lstat under -std=c11
+    #define _GNU_SOURCE
+#endif
+
+#include "LibFileScan.h"
+
+#ifdef __linux__
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <dirent.h>
+    #include <pthread.h>
+    #include <stdatomic.h>
+    #include <sys/stat.h>
+
+#define FILE_SCAN_BATCH_SIZE 64
+
+static size_t __internal_scan_thread_count(size_t thread_count){
+    if(thread_count > 0) return thread_count;
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if(cpus < 1) cpus = 1;
+
+    //Twice the cores so that threads blocked on a read still leave every core busy
+    return (size_t)cpus * 2;
+}
+
+static File_Type __internal_scan_classify(const char* file){
+    uint8_t header[FILE_TYPE_HEADER_SIZE];
+
+    int fd = open(file, O_RDONLY | O_CLOEXEC | O_NOCTTY);
+    if(fd < 0) return FILE_TYPE_UNKNOWN;
+
+    ssize_t header_size;
+    do{
+        header_size = read(fd, header, sizeof(header));
+    }while(header_size < 0 && errno == EINTR);
+
+    close(fd);
+
+    if(header_size <= 0) return FILE_TYPE_UNKNOWN;
+
+    return detect_buffer_type(header, (size_t)header_size);
+}
+
+typedef struct
+{
+    const char** files;
+    File_Type* results;
+    size_t count;
+    atomic_size_t next;
+}File_Scan_List;
+
+static void* __internal_scan_list_worker(void* arg){
+    File_Scan_List* list = (File_Scan_List*)arg;
+
+    for(;;){
+        size_t begin = atomic_fetch_add_explicit(&list->next, FILE_SCAN_BATCH_SIZE, memory_order_relaxed);
+        if(begin >= list->count) break;
+
+        size_t end = begin + FILE_SCAN_BATCH_SIZE;
+        if(end > list->count) end = list->count;
+
+        for(size_t i = begin; i < end; i++){
+            list->results[i] = __internal_scan_classify(list->files[i]);
+        }
+    }
+
+    return NULL;
+}
+
+bool classify_files(const char** files, size_t count, File_Type* results, size_t thread_count){
+    if(files == NULL || results == NULL){
+        fprintf(stderr, "[ERROR] classify_files files or results is NULL\n");
+        return false;
+    }
+
+    if(count == 0) return true;
+
+    thread_count = __internal_scan_thread_count(thread_count);
+    size_t batches = (count + FILE_SCAN_BATCH_SIZE - 1) / FILE_SCAN_BATCH_SIZE;
+    if(thread_count > batches) thread_count = batches;
+
+    File_Scan_List list = {
+        .files = files,
+        .results = results,
+        .count = count,
+    };
+    atomic_init(&list.next, 0);
+
+    pthread_t* threads = (pthread_t*)calloc(thread_count, sizeof(pthread_t));
+    if(threads == NULL){
+        fprintf(stderr, "[ERROR] Could not allocate memory\n");
+        return false;
+    }
+
+    size_t started = 0;
+    for(; started < thread_count; started++){
+        if(pthread_create(&threads[started], NULL, __internal_scan_list_worker, &list) != 0) break;
+    }
+
+    //Whatever was not picked up by the pool is classified here
+    __internal_scan_list_worker(&list);
+
+    for(size_t i = 0; i < started; i++){
+        pthread_join(threads[i], NULL);
+    }
+
+    free(threads);
+    return true;
+}
+
+typedef struct
+{
+    char* paths[FILE_SCAN_QUEUE_SIZE];
+    size_t head;
+    size_t count;
+    bool done;
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    File_Classify_Callback callback;
+    void* user_data;
+}File_Scan_Queue;
+
+static void __internal_scan_queue_push(File_Scan_Queue* queue, char* path){
+    pthread_mutex_lock(&queue->lock);
+
+    while(queue->count == FILE_SCAN_QUEUE_SIZE){
+        pthread_cond_wait(&queue->not_full, &queue->lock);
+    }
+
+    queue->paths[(queue->head + queue->count) % FILE_SCAN_QUEUE_SIZE] = path;
+    queue->count++;
+
+    pthread_cond_signal(&queue->not_empty);
+    pthread_mutex_unlock(&queue->lock);
+}
+
+static void* __internal_scan_queue_worker(void* arg){
+    File_Scan_Queue* queue = (File_Scan_Queue*)arg;
+
+    for(;;){
+        pthread_mutex_lock(&queue->lock);
+
+        while(queue->count == 0 && queue->done == false){
+            pthread_cond_wait(&queue->not_empty, &queue->lock);
+        }
+
+        if(queue->count == 0){
+            pthread_mutex_unlock(&queue->lock);
+            break;
+        }
+
+        char* path = queue->paths[queue->head];
+        queue->head = (queue->head + 1) % FILE_SCAN_QUEUE_SIZE;
+        queue->count--;
+
+        pthread_cond_signal(&queue->not_full);
+        pthread_mutex_unlock(&queue->lock);
+
+        queue->callback(path, __internal_scan_classify(path), queue->user_data);
+        free(path);
+    }
+
+    return NULL;
+}
+
+static char* __internal_scan_join_path(const char* directory, const char* name){
+    size_t directory_len = strlen(directory);
+    size_t name_len = strlen(name);
+    bool needs_separator = directory_len > 0 && directory[directory_len - 1] != '/';
+
+    char* path = (char*)malloc(directory_len + needs_separator + name_len + 1);
+    if(path == NULL) return NULL;
+
+    memcpy(path, directory, directory_len);
+    if(needs_separator) path[directory_len] = '/';
+    memcpy(path + directory_len + needs_separator, name, name_len + 1);
+
+    return path;
+}
+
+static void __internal_scan_walk(File_Scan_Queue* queue, const char* root){
+    size_t stack_size = 0;
+    size_t stack_capacity = 64;
+    char** stack = (char**)malloc(stack_capacity * sizeof(char*));
+    char* root_copy = strdup(root);
+
+    if(stack == NULL || root_copy == NULL){
+        fprintf(stderr, "[ERROR] Could not allocate memory\n");
+        free(stack);
+        free(root_copy);
+        return;
+    }
+    stack[stack_size++] = root_copy;
+
+    while(stack_size > 0){
+        char* directory = stack[--stack_size];
+
+        DIR* dir = opendir(directory);
+        if(dir == NULL){
+            fprintf(stderr, "[ERROR] Could not open directory %s: %s\n", directory, strerror(errno));
+            free(directory);
+            continue;
+        }
+
+        struct dirent* entry;
+        while((entry = readdir(dir)) != NULL){
+            if(strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) continue;
+
+            char* path = __internal_scan_join_path(directory, entry->d_name);
+            if(path == NULL){
+                fprintf(stderr, "[ERROR] Could not allocate memory\n");
+                continue;
+            }
+
+            unsigned char type = entry->d_type;
+            if(type == DT_UNKNOWN){
+                struct stat path_stat;
+                if(lstat(path, &path_stat) == 0){
+                    if(S_ISDIR(path_stat.st_mode)) type = DT_DIR;
+                    else if(S_ISREG(path_stat.st_mode)) type = DT_REG;
+                }
+            }
+
+            if(type == DT_REG){
+                __internal_scan_queue_push(queue, path);
+                continue;
+            }
+
+            if(type == DT_DIR){
+                if(stack_size == stack_capacity){
+                    char** grown = (char**)realloc(stack, stack_capacity * 2 * sizeof(char*));
+                    if(grown == NULL){
+                        fprintf(stderr, "[ERROR] Could not allocate memory\n");
+                        free(path);
+                        continue;
+                    }
+                    stack = grown;
+                    stack_capacity *= 2;
+                }
+                stack[stack_size++] = path;
+                continue;
+            }
+
+            //Symlinks, devices and sockets are not classified
+            free(path);
+        }
+
+        closedir(dir);
+        free(directory);
+    }
+
+    free(stack);
+}
+
+bool classify_directory(const char* root, size_t thread_count, File_Classify_Callback callback, void* user_data){
+    if(root == NULL || callback == NULL){
+        fprintf(stderr, "[ERROR] classify_directory root or callback is NULL\n");
+        return false;
+    }
+
+    thread_count = __internal_scan_thread_count(thread_count);
+
+    File_Scan_Queue* queue = (File_Scan_Queue*)calloc(1, sizeof(File_Scan_Queue));
+    pthread_t* threads = (pthread_t*)calloc(thread_count, sizeof(pthread_t));
+
+    if(queue == NULL || threads == NULL){
+        fprintf(stderr, "[ERROR] Could not allocate memory\n");
+        free(queue);
+        free(threads);
+        return false;
+    }
+
+    pthread_mutex_init(&queue->lock, NULL);
+    pthread_cond_init(&queue->not_empty, NULL);
+    pthread_cond_init(&queue->not_full, NULL);
+    queue->callback = callback;
+    queue->user_data = user_data;
+
+    size_t started = 0;
+    for(; started < thread_count; started++){
+        if(pthread_create(&threads[started], NULL, __internal_scan_queue_worker, queue) != 0) break;
+    }
+
+    if(started == 0){
+        fprintf(stderr, "[ERROR] Could not start any classify thread\n");
+        pthread_mutex_destroy(&queue->lock);
+        pthread_cond_destroy(&queue->not_empty);
+        pthread_cond_destroy(&queue->not_full);
+        free(queue);
+        free(threads);
+        return false;
+    }
+
+    __internal_scan_walk(queue, root);
+
+    pthread_mutex_lock(&queue->lock);
+    queue->done = true;
+    pthread_cond_broadcast(&queue->not_empty);
+    pthread_mutex_unlock(&queue->lock);
+
+    for(size_t i = 0; i < started; i++){
+        pthread_join(threads[i], NULL);
+    }
+
+    pthread_mutex_destroy(&queue->lock);
+    pthread_cond_destroy(&queue->not_empty);
+    pthread_cond_destroy(&queue->not_full);
+    free(queue);
+    free(threads);
+
+    return true;
+}
+#endif
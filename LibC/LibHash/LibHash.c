@@ -0,0 +1,668 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#include "LibHash.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#ifdef __linux__
+    #include <sys/stat.h>
+    #include "../LibFile/LibFile.h"
+#endif
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    #include <immintrin.h>
+    #define LIB_HASH_X86_64
+#endif
+
+#define HASH_CRC32C_POLY 0x82F63B78u
+//Lengths of the three interleaved streams of the hardware CRC, both powers of two
+#define HASH_CRC32C_LONG 8192
+#define HASH_CRC32C_SHORT 256
+
+#define HASH_XXH64_PRIME1 0x9E3779B185EBCA87ULL
+#define HASH_XXH64_PRIME2 0xC2B2AE3D27D4EB4FULL
+#define HASH_XXH64_PRIME3 0x165667B19E3779F9ULL
+#define HASH_XXH64_PRIME4 0x85EBCA77C2B2AE63ULL
+#define HASH_XXH64_PRIME5 0x27D4EB2F165667C5ULL
+
+#define HASH_MURMUR3_C1 0x87C37B91114253D5ULL
+#define HASH_MURMUR3_C2 0x4CF5AD432745937FULL
+
+static inline uint64_t __internal_hash_read64(const uint8_t* p){
+    uint64_t value;
+    memcpy(&value, p, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap64(value);
+#endif
+    return value;
+}
+
+static inline uint32_t __internal_hash_read32(const uint8_t* p){
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap32(value);
+#endif
+    return value;
+}
+
+static inline uint64_t __internal_hash_rotl64(uint64_t value, int bits){
+    return (value << bits) | (value >> (64 - bits));
+}
+
+///
+///CRC-32C
+///
+
+static uint32_t __internal_crc32c_table[8][256];
+static uint32_t __internal_crc32c_long[4][256];
+static uint32_t __internal_crc32c_short[4][256];
+
+//0 = not built, 1 = being built, 2 = ready
+static atomic_int __internal_crc32c_state;
+
+static uint32_t __internal_gf2_matrix_times(const uint32_t* matrix, uint32_t vector){
+    uint32_t sum = 0;
+
+    while(vector != 0){
+        if(vector & 1) sum ^= *matrix;
+        vector >>= 1;
+        matrix++;
+    }
+
+    return sum;
+}
+
+static void __internal_gf2_matrix_square(uint32_t* square, const uint32_t* matrix){
+    for(int n = 0; n < 32; n++){
+        square[n] = __internal_gf2_matrix_times(matrix, matrix[n]);
+    }
+}
+
+//Operator that appends length zero bytes (a power of two) to a raw CRC register
+static void __internal_crc32c_zeros_operator(uint32_t* even, size_t length){
+    uint32_t odd[32];
+
+    odd[0] = HASH_CRC32C_POLY;
+    uint32_t row = 1;
+    for(int n = 1; n < 32; n++){
+        odd[n] = row;
+        row <<= 1;
+    }
+
+    __internal_gf2_matrix_square(even, odd);  //2 zero bits
+    __internal_gf2_matrix_square(odd, even);  //4 zero bits
+
+    //Each square doubles the number of zero bits, starting from one byte
+    for(;;){
+        __internal_gf2_matrix_square(even, odd);
+        length >>= 1;
+        if(length == 0) return;
+
+        __internal_gf2_matrix_square(odd, even);
+        length >>= 1;
+        if(length == 0) break;
+    }
+
+    memcpy(even, odd, sizeof(odd));
+}
+
+static void __internal_crc32c_zeros_table(uint32_t table[4][256], size_t length){
+    uint32_t op[32];
+    __internal_crc32c_zeros_operator(op, length);
+
+    for(uint32_t n = 0; n < 256; n++){
+        table[0][n] = __internal_gf2_matrix_times(op, n);
+        table[1][n] = __internal_gf2_matrix_times(op, n << 8);
+        table[2][n] = __internal_gf2_matrix_times(op, n << 16);
+        table[3][n] = __internal_gf2_matrix_times(op, n << 24);
+    }
+}
+
+static void __internal_crc32c_build_tables(void){
+    if(atomic_load_explicit(&__internal_crc32c_state, memory_order_acquire) == 2) return;
+
+    int expected = 0;
+    if(atomic_compare_exchange_strong_explicit(&__internal_crc32c_state, &expected, 1, memory_order_acquire, memory_order_acquire) == false){
+        //Somebody else is building them, the tables are a few microseconds of work
+        while(atomic_load_explicit(&__internal_crc32c_state, memory_order_acquire) != 2){}
+        return;
+    }
+
+    for(uint32_t n = 0; n < 256; n++){
+        uint32_t crc = n;
+        for(int k = 0; k < 8; k++){
+            crc = crc & 1 ? (crc >> 1) ^ HASH_CRC32C_POLY : crc >> 1;
+        }
+        __internal_crc32c_table[0][n] = crc;
+    }
+
+    for(uint32_t n = 0; n < 256; n++){
+        uint32_t crc = __internal_crc32c_table[0][n];
+        for(int k = 1; k < 8; k++){
+            crc = __internal_crc32c_table[0][crc & 0xFF] ^ (crc >> 8);
+            __internal_crc32c_table[k][n] = crc;
+        }
+    }
+
+    __internal_crc32c_zeros_table(__internal_crc32c_long, HASH_CRC32C_LONG);
+    __internal_crc32c_zeros_table(__internal_crc32c_short, HASH_CRC32C_SHORT);
+
+    atomic_store_explicit(&__internal_crc32c_state, 2, memory_order_release);
+}
+
+static uint32_t __internal_crc32c_slicing(uint32_t crc, const uint8_t* p, size_t size){
+    while(size > 0 && ((uintptr_t)p & 7) != 0){
+        crc = __internal_crc32c_table[0][(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+        size--;
+    }
+
+    while(size >= 8){
+        uint64_t word = __internal_hash_read64(p) ^ crc;
+        crc = __internal_crc32c_table[7][word & 0xFF] ^
+              __internal_crc32c_table[6][(word >> 8) & 0xFF] ^
+              __internal_crc32c_table[5][(word >> 16) & 0xFF] ^
+              __internal_crc32c_table[4][(word >> 24) & 0xFF] ^
+              __internal_crc32c_table[3][(word >> 32) & 0xFF] ^
+              __internal_crc32c_table[2][(word >> 40) & 0xFF] ^
+              __internal_crc32c_table[1][(word >> 48) & 0xFF] ^
+              __internal_crc32c_table[0][word >> 56];
+        p += 8;
+        size -= 8;
+    }
+
+    while(size > 0){
+        crc = __internal_crc32c_table[0][(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+        size--;
+    }
+
+    return crc;
+}
+
+#ifdef LIB_HASH_X86_64
+static inline uint32_t __internal_crc32c_shift(uint32_t table[4][256], uint32_t crc){
+    return table[0][crc & 0xFF] ^ table[1][(crc >> 8) & 0xFF] ^ table[2][(crc >> 16) & 0xFF] ^ table[3][crc >> 24];
+}
+
+//The crc32 instruction has a latency of three cycles but a throughput of one, so three
+//independent streams keep it busy and are merged with the zeros operators afterwards
+__attribute__((target("sse4.2")))
+static uint32_t __internal_crc32c_sse42(uint32_t crc, const uint8_t* p, size_t size){
+    uint64_t crc0 = crc;
+
+    while(size > 0 && ((uintptr_t)p & 7) != 0){
+        crc0 = _mm_crc32_u8((uint32_t)crc0, *p++);
+        size--;
+    }
+
+    while(size >= HASH_CRC32C_LONG * 3){
+        uint64_t crc1 = 0;
+        uint64_t crc2 = 0;
+        const uint8_t* end = p + HASH_CRC32C_LONG;
+
+        do{
+            crc0 = _mm_crc32_u64(crc0, __internal_hash_read64(p));
+            crc1 = _mm_crc32_u64(crc1, __internal_hash_read64(p + HASH_CRC32C_LONG));
+            crc2 = _mm_crc32_u64(crc2, __internal_hash_read64(p + HASH_CRC32C_LONG * 2));
+            p += 8;
+        }while(p < end);
+
+        crc0 = __internal_crc32c_shift(__internal_crc32c_long, (uint32_t)crc0) ^ crc1;
+        crc0 = __internal_crc32c_shift(__internal_crc32c_long, (uint32_t)crc0) ^ crc2;
+        p += HASH_CRC32C_LONG * 2;
+        size -= HASH_CRC32C_LONG * 3;
+    }
+
+    while(size >= HASH_CRC32C_SHORT * 3){
+        uint64_t crc1 = 0;
+        uint64_t crc2 = 0;
+        const uint8_t* end = p + HASH_CRC32C_SHORT;
+
+        do{
+            crc0 = _mm_crc32_u64(crc0, __internal_hash_read64(p));
+            crc1 = _mm_crc32_u64(crc1, __internal_hash_read64(p + HASH_CRC32C_SHORT));
+            crc2 = _mm_crc32_u64(crc2, __internal_hash_read64(p + HASH_CRC32C_SHORT * 2));
+            p += 8;
+        }while(p < end);
+
+        crc0 = __internal_crc32c_shift(__internal_crc32c_short, (uint32_t)crc0) ^ crc1;
+        crc0 = __internal_crc32c_shift(__internal_crc32c_short, (uint32_t)crc0) ^ crc2;
+        p += HASH_CRC32C_SHORT * 2;
+        size -= HASH_CRC32C_SHORT * 3;
+    }
+
+    while(size >= 8){
+        crc0 = _mm_crc32_u64(crc0, __internal_hash_read64(p));
+        p += 8;
+        size -= 8;
+    }
+
+    while(size > 0){
+        crc0 = _mm_crc32_u8((uint32_t)crc0, *p++);
+        size--;
+    }
+
+    return (uint32_t)crc0;
+}
+#endif
+
+typedef uint32_t (*Hash_Crc32c_Kernel)(uint32_t crc, const uint8_t* p, size_t size);
+
+static Hash_Crc32c_Kernel __internal_crc32c_kernel(void){
+    //Every thread resolves to the same kernel, a racing first call just stores it twice
+    static _Atomic(Hash_Crc32c_Kernel) selected = NULL;
+    Hash_Crc32c_Kernel resolved = atomic_load_explicit(&selected, memory_order_acquire);
+    if(resolved != NULL) return resolved;
+
+    __internal_crc32c_build_tables();
+
+    Hash_Crc32c_Kernel kernel = __internal_crc32c_slicing;
+#ifdef LIB_HASH_X86_64
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("sse4.2")) kernel = __internal_crc32c_sse42;
+#endif
+
+    atomic_store_explicit(&selected, kernel, memory_order_release);
+    return kernel;
+}
+
+uint32_t hash_crc32c(uint32_t crc, const void* data, size_t size){
+    if(data == NULL) return crc;
+
+    //The register runs inverted so that chaining calls gives the CRC of the concatenation
+    return ~__internal_crc32c_kernel()(~crc, (const uint8_t*)data, size);
+}
+
+///
+///XXH64
+///
+
+static inline uint64_t __internal_xxh64_round(uint64_t accumulator, uint64_t input){
+    accumulator += input * HASH_XXH64_PRIME2;
+    accumulator = __internal_hash_rotl64(accumulator, 31);
+    return accumulator * HASH_XXH64_PRIME1;
+}
+
+static inline uint64_t __internal_xxh64_merge(uint64_t hash, uint64_t lane){
+    hash ^= __internal_xxh64_round(0, lane);
+    return hash * HASH_XXH64_PRIME1 + HASH_XXH64_PRIME4;
+}
+
+//Consumes whole 32 byte stripes, returns the number of bytes used
+static size_t __internal_xxh64_stripes(uint64_t lanes[4], const uint8_t* p, size_t size){
+    const uint8_t* start = p;
+    uint64_t v1 = lanes[0], v2 = lanes[1], v3 = lanes[2], v4 = lanes[3];
+
+    while(size >= 32){
+        v1 = __internal_xxh64_round(v1, __internal_hash_read64(p));
+        v2 = __internal_xxh64_round(v2, __internal_hash_read64(p + 8));
+        v3 = __internal_xxh64_round(v3, __internal_hash_read64(p + 16));
+        v4 = __internal_xxh64_round(v4, __internal_hash_read64(p + 24));
+        p += 32;
+        size -= 32;
+    }
+
+    lanes[0] = v1; lanes[1] = v2; lanes[2] = v3; lanes[3] = v4;
+    return (size_t)(p - start);
+}
+
+static uint64_t __internal_xxh64_finish(uint64_t hash, const uint8_t* p, size_t size){
+    while(size >= 8){
+        hash ^= __internal_xxh64_round(0, __internal_hash_read64(p));
+        hash = __internal_hash_rotl64(hash, 27) * HASH_XXH64_PRIME1 + HASH_XXH64_PRIME4;
+        p += 8;
+        size -= 8;
+    }
+
+    if(size >= 4){
+        hash ^= (uint64_t)__internal_hash_read32(p) * HASH_XXH64_PRIME1;
+        hash = __internal_hash_rotl64(hash, 23) * HASH_XXH64_PRIME2 + HASH_XXH64_PRIME3;
+        p += 4;
+        size -= 4;
+    }
+
+    while(size > 0){
+        hash ^= (*p++) * HASH_XXH64_PRIME5;
+        hash = __internal_hash_rotl64(hash, 11) * HASH_XXH64_PRIME1;
+        size--;
+    }
+
+    hash ^= hash >> 33;
+    hash *= HASH_XXH64_PRIME2;
+    hash ^= hash >> 29;
+    hash *= HASH_XXH64_PRIME3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+void hash_xxh64_init(Hash_Xxh64* state, uint64_t seed){
+    if(state == NULL) return;
+
+    state->lanes[0] = seed + HASH_XXH64_PRIME1 + HASH_XXH64_PRIME2;
+    state->lanes[1] = seed + HASH_XXH64_PRIME2;
+    state->lanes[2] = seed;
+    state->lanes[3] = seed - HASH_XXH64_PRIME1;
+    state->seed = seed;
+    state->total_size = 0;
+    state->buffered = 0;
+}
+
+void hash_xxh64_update(Hash_Xxh64* state, const void* data, size_t size){
+    if(state == NULL || data == NULL) return;
+
+    const uint8_t* p = (const uint8_t*)data;
+    state->total_size += size;
+
+    if(state->buffered > 0){
+        size_t needed = sizeof(state->buffer) - state->buffered;
+        size_t taken = size < needed ? size : needed;
+
+        memcpy(state->buffer + state->buffered, p, taken);
+        state->buffered += taken;
+        p += taken;
+        size -= taken;
+
+        if(state->buffered < sizeof(state->buffer)) return;
+
+        __internal_xxh64_stripes(state->lanes, state->buffer, sizeof(state->buffer));
+        state->buffered = 0;
+    }
+
+    size_t used = __internal_xxh64_stripes(state->lanes, p, size);
+
+    memcpy(state->buffer, p + used, size - used);
+    state->buffered = size - used;
+}
+
+uint64_t hash_xxh64_final(const Hash_Xxh64* state){
+    if(state == NULL) return 0;
+
+    uint64_t hash;
+    if(state->total_size >= 32){
+        const uint64_t* lanes = state->lanes;
+        hash = __internal_hash_rotl64(lanes[0], 1) + __internal_hash_rotl64(lanes[1], 7) +
+               __internal_hash_rotl64(lanes[2], 12) + __internal_hash_rotl64(lanes[3], 18);
+        hash = __internal_xxh64_merge(hash, lanes[0]);
+        hash = __internal_xxh64_merge(hash, lanes[1]);
+        hash = __internal_xxh64_merge(hash, lanes[2]);
+        hash = __internal_xxh64_merge(hash, lanes[3]);
+    }
+    else{
+        hash = state->seed + HASH_XXH64_PRIME5;
+    }
+
+    hash += state->total_size;
+    return __internal_xxh64_finish(hash, state->buffer, state->buffered);
+}
+
+uint64_t hash_xxh64(const void* data, size_t size, uint64_t seed){
+    if(data == NULL) size = 0;
+
+    //One shot hashing skips the copy through the state buffer
+    Hash_Xxh64 state;
+    hash_xxh64_init(&state, seed);
+
+    const uint8_t* p = (const uint8_t*)data;
+    size_t used = __internal_xxh64_stripes(state.lanes, p, size);
+
+    uint64_t hash;
+    if(size >= 32){
+        hash = __internal_hash_rotl64(state.lanes[0], 1) + __internal_hash_rotl64(state.lanes[1], 7) +
+               __internal_hash_rotl64(state.lanes[2], 12) + __internal_hash_rotl64(state.lanes[3], 18);
+        hash = __internal_xxh64_merge(hash, state.lanes[0]);
+        hash = __internal_xxh64_merge(hash, state.lanes[1]);
+        hash = __internal_xxh64_merge(hash, state.lanes[2]);
+        hash = __internal_xxh64_merge(hash, state.lanes[3]);
+    }
+    else{
+        hash = seed + HASH_XXH64_PRIME5;
+    }
+
+    hash += size;
+    return __internal_xxh64_finish(hash, p + used, size - used);
+}
+
+///
+///MurmurHash3_x64_128
+///
+
+static inline uint64_t __internal_murmur3_fmix64(uint64_t k){
+    k ^= k >> 33;
+    k *= 0xFF51AFD7ED558CCDULL;
+    k ^= k >> 33;
+    k *= 0xC4CEB9FE1A85EC53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+static size_t __internal_murmur3_blocks(uint64_t* h1_state, uint64_t* h2_state, const uint8_t* p, size_t size){
+    const uint8_t* start = p;
+    uint64_t h1 = *h1_state;
+    uint64_t h2 = *h2_state;
+
+    while(size >= 16){
+        uint64_t k1 = __internal_hash_read64(p);
+        uint64_t k2 = __internal_hash_read64(p + 8);
+
+        k1 *= HASH_MURMUR3_C1; k1 = __internal_hash_rotl64(k1, 31); k1 *= HASH_MURMUR3_C2; h1 ^= k1;
+        h1 = __internal_hash_rotl64(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52DCE729;
+
+        k2 *= HASH_MURMUR3_C2; k2 = __internal_hash_rotl64(k2, 33); k2 *= HASH_MURMUR3_C1; h2 ^= k2;
+        h2 = __internal_hash_rotl64(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495AB5;
+
+        p += 16;
+        size -= 16;
+    }
+
+    *h1_state = h1;
+    *h2_state = h2;
+    return (size_t)(p - start);
+}
+
+static Hash_128 __internal_murmur3_finish(uint64_t h1, uint64_t h2, const uint8_t* tail, size_t tail_size, uint64_t total_size){
+    uint64_t k1 = 0;
+    uint64_t k2 = 0;
+
+    for(size_t i = tail_size; i > 8; i--){
+        k2 = (k2 << 8) | tail[i - 1];
+    }
+    for(size_t i = tail_size < 8 ? tail_size : 8; i > 0; i--){
+        k1 = (k1 << 8) | tail[i - 1];
+    }
+
+    if(tail_size > 8){
+        k2 *= HASH_MURMUR3_C2; k2 = __internal_hash_rotl64(k2, 33); k2 *= HASH_MURMUR3_C1; h2 ^= k2;
+    }
+    if(tail_size > 0){
+        k1 *= HASH_MURMUR3_C1; k1 = __internal_hash_rotl64(k1, 31); k1 *= HASH_MURMUR3_C2; h1 ^= k1;
+    }
+
+    h1 ^= total_size;
+    h2 ^= total_size;
+
+    h1 += h2;
+    h2 += h1;
+
+    h1 = __internal_murmur3_fmix64(h1);
+    h2 = __internal_murmur3_fmix64(h2);
+
+    h1 += h2;
+    h2 += h1;
+
+    Hash_128 hash = {h1, h2};
+    return hash;
+}
+
+void hash_murmur3_init(Hash_Murmur3* state, uint32_t seed){
+    if(state == NULL) return;
+
+    state->h1 = seed;
+    state->h2 = seed;
+    state->total_size = 0;
+    state->buffered = 0;
+}
+
+void hash_murmur3_update(Hash_Murmur3* state, const void* data, size_t size){
+    if(state == NULL || data == NULL) return;
+
+    const uint8_t* p = (const uint8_t*)data;
+    state->total_size += size;
+
+    if(state->buffered > 0){
+        size_t needed = sizeof(state->buffer) - state->buffered;
+        size_t taken = size < needed ? size : needed;
+
+        memcpy(state->buffer + state->buffered, p, taken);
+        state->buffered += taken;
+        p += taken;
+        size -= taken;
+
+        if(state->buffered < sizeof(state->buffer)) return;
+
+        __internal_murmur3_blocks(&state->h1, &state->h2, state->buffer, sizeof(state->buffer));
+        state->buffered = 0;
+    }
+
+    size_t used = __internal_murmur3_blocks(&state->h1, &state->h2, p, size);
+
+    memcpy(state->buffer, p + used, size - used);
+    state->buffered = size - used;
+}
+
+Hash_128 hash_murmur3_final(const Hash_Murmur3* state){
+    if(state == NULL){
+        Hash_128 empty = {0, 0};
+        return empty;
+    }
+
+    return __internal_murmur3_finish(state->h1, state->h2, state->buffer, state->buffered, state->total_size);
+}
+
+Hash_128 hash_murmur3_128(const void* data, size_t size, uint32_t seed){
+    if(data == NULL) size = 0;
+
+    const uint8_t* p = (const uint8_t*)data;
+    uint64_t h1 = seed;
+    uint64_t h2 = seed;
+
+    size_t used = __internal_murmur3_blocks(&h1, &h2, p, size);
+    return __internal_murmur3_finish(h1, h2, p + used, size - used, size);
+}
+
+uint32_t hash_sv_crc32c(String_View sv){
+    return hash_crc32c(0, sv.string, sv.size);
+}
+
+uint64_t hash_sv_xxh64(String_View sv, uint64_t seed){
+    return hash_xxh64(sv.string, sv.size, seed);
+}
+
+Hash_128 hash_sv_murmur3_128(String_View sv, uint32_t seed){
+    return hash_murmur3_128(sv.string, sv.size, seed);
+}
+
+///
+///Files
+///
+
+#ifdef __linux__
+typedef void (*Hash_Update)(void* state, const void* data, size_t size);
+
+static bool __internal_hash_file(const char* file, void* state, Hash_Update update){
+    //Pipes cannot be mapped and pseudo files report size 0, both have to be read
+    struct stat file_stat;
+    if(stat(file, &file_stat) == 0 && S_ISREG(file_stat.st_mode) && file_stat.st_size > 0){
+        Mapped_File mapped_file;
+        if(map_file(&mapped_file, file, false) == false) return false;
+
+        advise_mapped_file(&mapped_file, FILE_ADVICE_SEQUENTIAL);
+        update(state, mapped_file.data, mapped_file.size);
+        unmap_file(&mapped_file);
+        return true;
+    }
+
+    File_Reader reader;
+    if(file_reader_open(&reader, file, FILE_READER_DEFAULT_BUFFER_SIZE) == false) return false;
+
+    String_View chunk;
+    while(file_reader_next_chunk(&reader, &chunk)){
+        update(state, chunk.string, chunk.size);
+    }
+
+    //A read error ends the loop like the end of the file, the hash would cover a truncated input
+    bool failed = file_reader_failed(&reader);
+    file_reader_close(&reader);
+
+    return failed == false;
+}
+
+static void __internal_hash_crc32c_update(void* state, const void* data, size_t size){
+    uint32_t* crc = (uint32_t*)state;
+    *crc = hash_crc32c(*crc, data, size);
+}
+
+static void __internal_hash_xxh64_update(void* state, const void* data, size_t size){
+    hash_xxh64_update((Hash_Xxh64*)state, data, size);
+}
+
+static void __internal_hash_murmur3_update(void* state, const void* data, size_t size){
+    hash_murmur3_update((Hash_Murmur3*)state, data, size);
+}
+
+bool hash_file_crc32c(const char* file, uint32_t* crc){
+    if(crc == NULL) return false;
+
+    uint32_t state = 0;
+    if(__internal_hash_file(file, &state, __internal_hash_crc32c_update) == false) return false;
+
+    *crc = state;
+    return true;
+}
+
+bool hash_file_xxh64(const char* file, uint64_t seed, uint64_t* hash){
+    if(hash == NULL) return false;
+
+    Hash_Xxh64 state;
+    hash_xxh64_init(&state, seed);
+    if(__internal_hash_file(file, &state, __internal_hash_xxh64_update) == false) return false;
+
+    *hash = hash_xxh64_final(&state);
+    return true;
+}
+
+bool hash_file_murmur3_128(const char* file, uint32_t seed, Hash_128* hash){
+    if(hash == NULL) return false;
+
+    Hash_Murmur3 state;
+    hash_murmur3_init(&state, seed);
+    if(__internal_hash_file(file, &state, __internal_hash_murmur3_update) == false) return false;
+
+    *hash = hash_murmur3_final(&state);
+    return true;
+}
+#endif
@@ -0,0 +1,85 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "../LibString/LibStringView.h"
+
+typedef struct
+{
+    uint64_t low;
+    uint64_t high;
+}Hash_128;
+
+typedef struct
+{
+    uint64_t lanes[4];
+    uint64_t seed;
+    uint64_t total_size;
+    uint8_t buffer[32];
+    size_t buffered;
+}Hash_Xxh64;
+
+typedef struct
+{
+    uint64_t h1;
+    uint64_t h2;
+    uint64_t total_size;
+    uint8_t buffer[16];
+    size_t buffered;
+}Hash_Murmur3;
+
+//CRC-32C (Castagnoli), SSE4.2 instructions when the CPU has them and slicing-by-8 otherwise.
+//Start from 0 and feed the previous result back in to hash a stream piece by piece.
+uint32_t hash_crc32c(uint32_t crc, const void* data, size_t size);
+
+uint64_t hash_xxh64(const void* data, size_t size, uint64_t seed);
+void hash_xxh64_init(Hash_Xxh64* state, uint64_t seed);
+void hash_xxh64_update(Hash_Xxh64* state, const void* data, size_t size);
+uint64_t hash_xxh64_final(const Hash_Xxh64* state);
+
+//MurmurHash3_x64_128
+Hash_128 hash_murmur3_128(const void* data, size_t size, uint32_t seed);
+void hash_murmur3_init(Hash_Murmur3* state, uint32_t seed);
+void hash_murmur3_update(Hash_Murmur3* state, const void* data, size_t size);
+Hash_128 hash_murmur3_final(const Hash_Murmur3* state);
+
+uint32_t hash_sv_crc32c(String_View sv);
+uint64_t hash_sv_xxh64(String_View sv, uint64_t seed);
+Hash_128 hash_sv_murmur3_128(String_View sv, uint32_t seed);
+
+#ifdef __linux__
+//Regular files are hashed through a read-only mapping, anything that cannot be mapped
+//(pipes, /proc) is read in chunks.
+//A mapped file truncated while it is being hashed (a log rotated underneath, for example) raises
+//SIGBUS. For files that may shrink concurrently, feed File_Reader chunks to hash_crc32c or the
+//hash_*_update functions instead.
+bool hash_file_crc32c(const char* file, uint32_t* crc);
+bool hash_file_xxh64(const char* file, uint64_t seed, uint64_t* hash);
+bool hash_file_murmur3_128(const char* file, uint32_t seed, Hash_128* hash);
+#endif
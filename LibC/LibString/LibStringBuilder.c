@@ -0,0 +1,197 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#include "LibStringBuilder.h"
+#include <stdio.h>
+
+void sb_init(String_Builder* sb){
+    if(sb == NULL) return;
+
+    sb->heap = NULL;
+    sb->size = 0;
+    sb->capacity = STRING_BUILDER_INLINE_SIZE;
+    sb->inline_buffer[0] = '\0';
+}
+
+char* sb_data(String_Builder* sb){
+    return sb->heap != NULL ? sb->heap : sb->inline_buffer;
+}
+
+void sb_reset(String_Builder* sb){
+    if(sb == NULL) return;
+
+    sb->size = 0;
+    sb_data(sb)[0] = '\0';
+}
+
+void sb_free(String_Builder* sb){
+    if(sb == NULL) return;
+
+    free(sb->heap);
+    sb_init(sb);
+}
+
+bool sb_reserve(String_Builder* sb, size_t additional){
+    if(sb == NULL) return false;
+
+    //String_Builder sb = {0} has not been through sb_init, it starts on the inline buffer
+    if(sb->heap == NULL && sb->capacity == 0) sb->capacity = STRING_BUILDER_INLINE_SIZE;
+
+    //One byte is always kept for the terminator
+    if(additional > SIZE_MAX - sb->size - 1){
+        fprintf(stderr, "[ERROR] String_Builder size overflow\n");
+        return false;
+    }
+
+    size_t needed = sb->size + additional + 1;
+    if(needed <= sb->capacity) return true;
+
+    size_t capacity = sb->capacity;
+    while(capacity < needed){
+        capacity = capacity > SIZE_MAX / 2 ? needed : capacity * 2;
+    }
+
+    char* grown;
+    if(sb->heap == NULL){
+        grown = (char*)malloc(capacity);
+        if(grown != NULL) memcpy(grown, sb->inline_buffer, sb->size + 1);
+    }
+    else{
+        grown = (char*)realloc(sb->heap, capacity);
+    }
+
+    if(grown == NULL){
+        fprintf(stderr, "[ERROR] Could not allocate memory\n");
+        return false;
+    }
+
+    sb->heap = grown;
+    sb->capacity = capacity;
+
+    return true;
+}
+
+bool sb_append_buffer(String_Builder* sb, const void* data, size_t size){
+    if(sb == NULL || (data == NULL && size > 0)) return false;
+    if(sb_reserve(sb, size) == false) return false;
+
+    char* buffer = sb_data(sb);
+    memcpy(buffer + sb->size, data, size);
+    sb->size += size;
+    buffer[sb->size] = '\0';
+
+    return true;
+}
+
+bool sb_append_sv(String_Builder* sb, String_View sv){
+    return sb_append_buffer(sb, sv.string, sv.size);
+}
+
+bool sb_append_cstr(String_Builder* sb, const char* string){
+    if(string == NULL) return false;
+    return sb_append_buffer(sb, string, strlen(string));
+}
+
+bool sb_append_char(String_Builder* sb, char c){
+    if(sb == NULL) return false;
+    if(sb->size + 1 >= sb->capacity && sb_reserve(sb, 1) == false) return false;
+
+    char* buffer = sb_data(sb);
+    buffer[sb->size++] = c;
+    buffer[sb->size] = '\0';
+
+    return true;
+}
+
+bool sb_vappendf(String_Builder* sb, const char* format, va_list args){
+    if(sb == NULL || format == NULL) return false;
+
+    //Format straight into the spare capacity, only a second pass is needed when it does not fit
+    va_list retry;
+    va_copy(retry, args);
+
+    size_t available = sb->capacity - sb->size;
+    int written = vsnprintf(sb_data(sb) + sb->size, available, format, args);
+
+    if(written < 0){
+        va_end(retry);
+        sb_data(sb)[sb->size] = '\0';
+        return false;
+    }
+
+    if((size_t)written >= available){
+        if(sb_reserve(sb, (size_t)written) == false){
+            va_end(retry);
+            sb_data(sb)[sb->size] = '\0';
+            return false;
+        }
+        vsnprintf(sb_data(sb) + sb->size, sb->capacity - sb->size, format, retry);
+    }
+
+    va_end(retry);
+    sb->size += (size_t)written;
+
+    return true;
+}
+
+bool sb_appendf(String_Builder* sb, const char* format, ...){
+    va_list args;
+    va_start(args, format);
+    bool appended = sb_vappendf(sb, format, args);
+    va_end(args);
+
+    return appended;
+}
+
+String_View sb_to_sv(const String_Builder* sb){
+    String_View sv = {0};
+
+    if(sb == NULL){
+        sv.string = "";
+        return sv;
+    }
+
+    sv.string = sb->heap != NULL ? sb->heap : sb->inline_buffer;
+    sv.size = sb->size;
+
+    return sv;
+}
+
+char* sb_to_cstr(String_Builder* sb){
+    if(sb == NULL) return NULL;
+
+    char* result = sb->heap;
+
+    if(result == NULL){
+        result = (char*)malloc(sb->size + 1);
+        if(result == NULL){
+            fprintf(stderr, "[ERROR] Could not allocate memory\n");
+            return NULL;
+        }
+        memcpy(result, sb->inline_buffer, sb->size + 1);
+    }
+
+    sb_init(sb);
+    return result;
+}
@@ -0,0 +1,66 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+
+#include <stdarg.h>
+
+#include "LibStringView.h"
+
+#define STRING_BUILDER_INLINE_SIZE 64
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define __internal_sb_printf(format_index, args_index) __attribute__((format(printf, format_index, args_index)))
+#else
+    #define __internal_sb_printf(format_index, args_index)
+#endif
+
+//Short strings live in inline_buffer, longer ones move to a heap buffer that grows geometrically.
+//The content is always NUL terminated. A zero-initialised builder is a valid empty one.
+typedef struct
+{
+    char* heap;
+    size_t size;
+    size_t capacity;
+    char inline_buffer[STRING_BUILDER_INLINE_SIZE];
+}String_Builder;
+
+void sb_init(String_Builder* sb);
+void sb_reset(String_Builder* sb);
+void sb_free(String_Builder* sb);
+bool sb_reserve(String_Builder* sb, size_t additional);
+
+bool sb_append_buffer(String_Builder* sb, const void* data, size_t size);
+bool sb_append_sv(String_Builder* sb, String_View sv);
+bool sb_append_cstr(String_Builder* sb, const char* string);
+bool sb_append_char(String_Builder* sb, char c);
+bool sb_appendf(String_Builder* sb, const char* format, ...) __internal_sb_printf(2, 3);
+bool sb_vappendf(String_Builder* sb, const char* format, va_list args);
+
+char* sb_data(String_Builder* sb);
+//Borrowed view, valid until the builder is modified
+String_View sb_to_sv(const String_Builder* sb);
+//Hands the buffer over to the caller (free it) and leaves the builder empty;
+//only a string still in the inline buffer needs a copy
+char* sb_to_cstr(String_Builder* sb);
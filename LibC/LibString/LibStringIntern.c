@@ -0,0 +1,222 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#include "LibStringIntern.h"
+#include <stdio.h>
+
+#define STRING_INTERN_INITIAL_CAPACITY 64
+
+typedef struct
+{
+    uint64_t hash;
+    String_View sv;
+    atomic_uint_fast32_t id_plus_one;
+}String_Intern_Slot;
+
+struct String_Intern_Table
+{
+    size_t mask;
+    String_Intern_Slot slots[];
+};
+
+struct String_Intern_Views
+{
+    size_t capacity;
+    String_View views[];
+};
+
+//Tables and view arrays live in the arena, so a reader still holding an old one after a grow stays valid
+static String_Intern_Table* __internal_intern_new_table(String_Intern* intern, size_t capacity){
+    String_Intern_Table* table = (String_Intern_Table*)arena_alloc(&intern->arena, sizeof(String_Intern_Table) + capacity * sizeof(String_Intern_Slot));
+    if(table == NULL) return NULL;
+
+    table->mask = capacity - 1;
+    for(size_t i = 0; i < capacity; i++){
+        table->slots[i].hash = 0;
+        table->slots[i].sv.string = NULL;
+        table->slots[i].sv.size = 0;
+        atomic_init(&table->slots[i].id_plus_one, 0);
+    }
+
+    return table;
+}
+
+static String_Intern_Views* __internal_intern_new_views(String_Intern* intern, size_t capacity){
+    String_Intern_Views* views = (String_Intern_Views*)arena_alloc(&intern->arena, sizeof(String_Intern_Views) + capacity * sizeof(String_View));
+    if(views == NULL) return NULL;
+
+    views->capacity = capacity;
+    return views;
+}
+
+bool string_intern_init(String_Intern* intern, bool concurrent){
+    if(intern == NULL){
+        fprintf(stderr, "[ERROR] string_intern_init(NULL, %d) intern is NULL\n", concurrent);
+        return false;
+    }
+
+    arena_init(&intern->arena, 0);
+    atomic_init(&intern->count, 0);
+    intern->concurrent = concurrent;
+    pthread_mutex_init(&intern->lock, NULL);
+
+    String_Intern_Table* table = __internal_intern_new_table(intern, STRING_INTERN_INITIAL_CAPACITY);
+    String_Intern_Views* views = __internal_intern_new_views(intern, STRING_INTERN_INITIAL_CAPACITY / 2);
+    if(table == NULL || views == NULL){
+        arena_free(&intern->arena);
+        pthread_mutex_destroy(&intern->lock);
+        return false;
+    }
+
+    atomic_init(&intern->table, table);
+    atomic_init(&intern->views, views);
+
+    return true;
+}
+
+void string_intern_free(String_Intern* intern){
+    if(intern == NULL) return;
+
+    arena_free(&intern->arena);
+    pthread_mutex_destroy(&intern->lock);
+    atomic_store(&intern->table, NULL);
+    atomic_store(&intern->views, NULL);
+    atomic_store(&intern->count, 0);
+}
+
+size_t string_intern_count(String_Intern* intern){
+    if(intern == NULL) return 0;
+    return (size_t)atomic_load_explicit(&intern->count, memory_order_acquire);
+}
+
+static bool __internal_intern_lookup(String_Intern_Table* table, String_View sv, uint64_t hash, uint32_t* id){
+    for(size_t index = hash & table->mask;; index = (index + 1) & table->mask){
+        String_Intern_Slot* slot = &table->slots[index];
+        uint32_t id_plus_one = (uint32_t)atomic_load_explicit(&slot->id_plus_one, memory_order_acquire);
+
+        if(id_plus_one == 0) return false;
+
+        if(slot->hash == hash && sv_cmp(slot->sv, sv)){
+            *id = id_plus_one - 1;
+            return true;
+        }
+    }
+}
+
+bool sv_intern_find(String_Intern* intern, String_View sv, uint32_t* id){
+    if(intern == NULL || id == NULL) return false;
+
+    String_Intern_Table* table = atomic_load_explicit(&intern->table, memory_order_acquire);
+    if(table == NULL) return false;
+
+    return __internal_intern_lookup(table, sv, sv_hash(sv), id);
+}
+
+static void __internal_intern_place(String_Intern_Table* table, uint64_t hash, String_View sv, uint32_t id){
+    size_t index = hash & table->mask;
+    while(atomic_load_explicit(&table->slots[index].id_plus_one, memory_order_relaxed) != 0){
+        index = (index + 1) & table->mask;
+    }
+
+    table->slots[index].hash = hash;
+    table->slots[index].sv = sv;
+    atomic_store_explicit(&table->slots[index].id_plus_one, id + 1, memory_order_release);
+}
+
+static uint32_t __internal_intern_insert(String_Intern* intern, String_View sv, uint64_t hash){
+    String_Intern_Table* table = atomic_load_explicit(&intern->table, memory_order_relaxed);
+
+    //Another writer may have inserted it while we were waiting for the lock
+    uint32_t id;
+    if(__internal_intern_lookup(table, sv, hash, &id)) return id;
+
+    uint32_t count = (uint32_t)atomic_load_explicit(&intern->count, memory_order_relaxed);
+    if(count == STRING_INTERN_INVALID - 1){
+        fprintf(stderr, "[ERROR] String intern table is full\n");
+        return STRING_INTERN_INVALID;
+    }
+
+    char* copy = arena_strndup(&intern->arena, sv.string, sv.size);
+    if(copy == NULL) return STRING_INTERN_INVALID;
+    String_View canonical = sv_from_parts(copy, sv.size);
+
+    String_Intern_Views* views = atomic_load_explicit(&intern->views, memory_order_relaxed);
+    if(count == views->capacity){
+        String_Intern_Views* grown = __internal_intern_new_views(intern, views->capacity * 2);
+        if(grown == NULL) return STRING_INTERN_INVALID;
+
+        memcpy(grown->views, views->views, count * sizeof(String_View));
+        atomic_store_explicit(&intern->views, grown, memory_order_release);
+        views = grown;
+    }
+    views->views[count] = canonical;
+
+    //Keep the load factor at or below one half
+    if((size_t)(count + 1) * 2 > table->mask + 1){
+        String_Intern_Table* grown = __internal_intern_new_table(intern, (table->mask + 1) * 2);
+        if(grown == NULL) return STRING_INTERN_INVALID;
+
+        for(size_t i = 0; i <= table->mask; i++){
+            uint32_t id_plus_one = (uint32_t)atomic_load_explicit(&table->slots[i].id_plus_one, memory_order_relaxed);
+            if(id_plus_one == 0) continue;
+            __internal_intern_place(grown, table->slots[i].hash, table->slots[i].sv, id_plus_one - 1);
+        }
+
+        atomic_store_explicit(&intern->table, grown, memory_order_release);
+        table = grown;
+    }
+
+    //The count goes first: a reader that finds the id in the table must also see it as valid
+    atomic_store_explicit(&intern->count, count + 1, memory_order_release);
+    __internal_intern_place(table, hash, canonical, count);
+
+    return count;
+}
+
+uint32_t sv_intern(String_Intern* intern, String_View sv){
+    if(intern == NULL) return STRING_INTERN_INVALID;
+
+    uint64_t hash = sv_hash(sv);
+
+    String_Intern_Table* table = atomic_load_explicit(&intern->table, memory_order_acquire);
+    if(table == NULL) return STRING_INTERN_INVALID;
+
+    uint32_t id;
+    if(__internal_intern_lookup(table, sv, hash, &id)) return id;
+
+    if(intern->concurrent) pthread_mutex_lock(&intern->lock);
+    id = __internal_intern_insert(intern, sv, hash);
+    if(intern->concurrent) pthread_mutex_unlock(&intern->lock);
+
+    return id;
+}
+
+String_View sv_intern_view(String_Intern* intern, uint32_t id){
+    String_View empty = sv_from_parts("", 0);
+
+    if(intern == NULL || id >= (uint32_t)atomic_load_explicit(&intern->count, memory_order_acquire)) return empty;
+
+    String_Intern_Views* views = atomic_load_explicit(&intern->views, memory_order_acquire);
+    return views->views[id];
+}
@@ -0,0 +1,59 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "LibStringView.h"
+#include "../LibArena/LibArena.h"
+
+#define STRING_INTERN_INVALID UINT32_MAX
+
+typedef struct String_Intern_Table String_Intern_Table;
+typedef struct String_Intern_Views String_Intern_Views;
+
+//Lookups never lock. With concurrent set, inserts from several threads are serialized by a mutex;
+//without it only one thread may insert while others look up.
+typedef struct
+{
+    Arena arena;
+    _Atomic(String_Intern_Table*) table;
+    _Atomic(String_Intern_Views*) views;
+    atomic_uint_fast32_t count;
+    bool concurrent;
+    pthread_mutex_t lock;
+}String_Intern;
+
+bool string_intern_init(String_Intern* intern, bool concurrent);
+void string_intern_free(String_Intern* intern);
+size_t string_intern_count(String_Intern* intern);
+
+//Returns the stable id of sv, inserting a NUL terminated copy on first sight
+uint32_t sv_intern(String_Intern* intern, String_View sv);
+bool sv_intern_find(String_Intern* intern, String_View sv, uint32_t* id);
+//The canonical view: interned equal strings share the same .string pointer
+String_View sv_intern_view(String_Intern* intern, uint32_t id);
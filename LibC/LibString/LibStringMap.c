@@ -0,0 +1,333 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#include "LibStringMap.h"
+#include <stdio.h>
+
+#ifdef _WIN32
+    #include <malloc.h>
+#endif
+
+#if (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__))) && (defined(__GNUC__) || defined(__clang__))
+    #include <emmintrin.h>
+    #define LIB_STRING_MAP_SSE2
+#endif
+
+#define STRING_MAP_EMPTY   ((int8_t)-128)
+#define STRING_MAP_DELETED ((int8_t)-2)
+#define STRING_MAP_MIN_CAPACITY STRING_MAP_GROUP_SIZE
+
+static inline bool __internal_map_is_full(int8_t ctrl){
+    return ctrl >= 0;
+}
+
+static inline uint8_t __internal_map_h2(uint64_t hash){
+    return (uint8_t)(hash & 0x7F);
+}
+
+static inline size_t __internal_map_h1(uint64_t hash){
+    return (size_t)(hash >> 7);
+}
+
+//Bit i of the result is set when ctrl[i] == value
+static inline unsigned __internal_map_match(const int8_t* group, int8_t value){
+#ifdef LIB_STRING_MAP_SSE2
+    __m128i ctrl = _mm_load_si128((const __m128i*)group);
+    return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(value)));
+#else
+    unsigned mask = 0;
+    for(unsigned i = 0; i < STRING_MAP_GROUP_SIZE; i++){
+        if(group[i] == value) mask |= 1u << i;
+    }
+    return mask;
+#endif
+}
+
+//Bit i is set when ctrl[i] is empty or deleted, both have the sign bit set
+static inline unsigned __internal_map_match_free(const int8_t* group){
+#ifdef LIB_STRING_MAP_SSE2
+    return (unsigned)_mm_movemask_epi8(_mm_load_si128((const __m128i*)group));
+#else
+    unsigned mask = 0;
+    for(unsigned i = 0; i < STRING_MAP_GROUP_SIZE; i++){
+        if(group[i] < 0) mask |= 1u << i;
+    }
+    return mask;
+#endif
+}
+
+//Returns 0 when no table can hold count entries
+static inline size_t __internal_map_capacity_for(size_t count){
+    const size_t max_capacity = SIZE_MAX / sizeof(String_Map_Entry);
+
+    //Maximum load factor is 7/8
+    if(count > max_capacity / 2) return 0;
+    size_t needed = count + count / 7 + 1;
+
+    size_t capacity = STRING_MAP_MIN_CAPACITY;
+    while(capacity < needed){
+        if(capacity > max_capacity / 2) return 0;
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+//The control bytes are loaded a group at a time with aligned loads. The Windows CRT has no
+//aligned_alloc and its aligned blocks must be released with _aligned_free.
+static int8_t* __internal_map_ctrl_alloc(size_t capacity){
+#ifdef _WIN32
+    return (int8_t*)_aligned_malloc(capacity, STRING_MAP_GROUP_SIZE);
+#else
+    return (int8_t*)aligned_alloc(STRING_MAP_GROUP_SIZE, capacity);
+#endif
+}
+
+static void __internal_map_ctrl_free(int8_t* ctrl){
+#ifdef _WIN32
+    _aligned_free(ctrl);
+#else
+    free(ctrl);
+#endif
+}
+
+static bool __internal_map_allocate(String_Map* map, size_t capacity){
+    int8_t* ctrl = __internal_map_ctrl_alloc(capacity);
+    String_Map_Entry* entries = (String_Map_Entry*)malloc(capacity * sizeof(String_Map_Entry));
+
+    if(ctrl == NULL || entries == NULL){
+        fprintf(stderr, "[ERROR] Could not allocate memory\n");
+        __internal_map_ctrl_free(ctrl);
+        free(entries);
+        return false;
+    }
+
+    memset(ctrl, STRING_MAP_EMPTY, capacity);
+
+    map->ctrl = ctrl;
+    map->entries = entries;
+    map->capacity = capacity;
+    map->growth_left = capacity - capacity / 8 - map->size;
+
+    return true;
+}
+
+//Index of the first free slot on the probe sequence of hash
+static size_t __internal_map_find_free(const String_Map* map, uint64_t hash){
+    size_t group_mask = map->capacity / STRING_MAP_GROUP_SIZE - 1;
+    size_t group = __internal_map_h1(hash) & group_mask;
+
+    for(size_t step = 1;; step++){
+        const int8_t* ctrl = map->ctrl + group * STRING_MAP_GROUP_SIZE;
+        unsigned free_mask = __internal_map_match_free(ctrl);
+        if(free_mask != 0) return group * STRING_MAP_GROUP_SIZE + (size_t)__builtin_ctz(free_mask);
+
+        group = (group + step) & group_mask;
+    }
+}
+
+static bool __internal_map_rehash(String_Map* map, size_t capacity){
+    int8_t* old_ctrl = map->ctrl;
+    String_Map_Entry* old_entries = map->entries;
+    size_t old_capacity = map->capacity;
+
+    if(__internal_map_allocate(map, capacity) == false){
+        map->ctrl = old_ctrl;
+        map->entries = old_entries;
+        map->capacity = old_capacity;
+        return false;
+    }
+
+    for(size_t i = 0; i < old_capacity; i++){
+        if(__internal_map_is_full(old_ctrl[i]) == false) continue;
+
+        uint64_t hash = sv_hash(old_entries[i].key);
+        size_t slot = __internal_map_find_free(map, hash);
+        map->ctrl[slot] = (int8_t)__internal_map_h2(hash);
+        map->entries[slot] = old_entries[i];
+    }
+
+    __internal_map_ctrl_free(old_ctrl);
+    free(old_entries);
+
+    return true;
+}
+
+bool string_map_init(String_Map* map, bool owned_keys){
+    if(map == NULL){
+        fprintf(stderr, "[ERROR] string_map_init(NULL, %d) map is NULL\n", owned_keys);
+        return false;
+    }
+
+    memset(map, 0, sizeof(*map));
+    map->owned_keys = owned_keys;
+
+    return __internal_map_allocate(map, STRING_MAP_MIN_CAPACITY);
+}
+
+void string_map_free(String_Map* map){
+    if(map == NULL) return;
+
+    if(map->owned_keys){
+        for(size_t i = 0; i < map->capacity; i++){
+            if(__internal_map_is_full(map->ctrl[i])) free((char*)map->entries[i].key.string);
+        }
+    }
+
+    __internal_map_ctrl_free(map->ctrl);
+    free(map->entries);
+    memset(map, 0, sizeof(*map));
+}
+
+bool string_map_reserve(String_Map* map, size_t count){
+    if(map == NULL) return false;
+
+    size_t capacity = __internal_map_capacity_for(count);
+    if(capacity == 0){
+        fprintf(stderr, "[ERROR] string_map_reserve count %zu is too large\n", count);
+        return false;
+    }
+    if(capacity <= map->capacity) return true;
+
+    return __internal_map_rehash(map, capacity);
+}
+
+static size_t __internal_map_find(const String_Map* map, String_View key, uint64_t hash){
+    size_t group_mask = map->capacity / STRING_MAP_GROUP_SIZE - 1;
+    size_t group = __internal_map_h1(hash) & group_mask;
+    int8_t h2 = (int8_t)__internal_map_h2(hash);
+
+    for(size_t step = 1; step <= group_mask + 1; step++){
+        const int8_t* ctrl = map->ctrl + group * STRING_MAP_GROUP_SIZE;
+
+        for(unsigned match = __internal_map_match(ctrl, h2); match != 0; match &= match - 1){
+            size_t slot = group * STRING_MAP_GROUP_SIZE + (size_t)__builtin_ctz(match);
+            if(sv_cmp(map->entries[slot].key, key)) return slot;
+        }
+
+        //A group with an empty slot ends every probe sequence that reaches it
+        if(__internal_map_match(ctrl, STRING_MAP_EMPTY) != 0) return SIZE_MAX;
+
+        group = (group + step) & group_mask;
+    }
+
+    return SIZE_MAX;
+}
+
+bool string_map_put(String_Map* map, String_View key, void* value){
+    if(map == NULL) return false;
+
+    //String_Map map = {0} skipped string_map_init, it gets its table on the first insertion
+    if(map->capacity == 0 && __internal_map_allocate(map, STRING_MAP_MIN_CAPACITY) == false) return false;
+
+    uint64_t hash = sv_hash(key);
+    size_t slot = __internal_map_find(map, key, hash);
+
+    if(slot != SIZE_MAX){
+        map->entries[slot].value = value;
+        return true;
+    }
+
+    slot = __internal_map_find_free(map, hash);
+
+    if(map->ctrl[slot] == STRING_MAP_EMPTY && map->growth_left == 0){
+        //Mostly tombstones: clean them up in place, otherwise double
+        size_t capacity = map->size + 1 > (map->capacity - map->capacity / 8) / 2 ? map->capacity * 2 : map->capacity;
+        if(capacity < map->capacity || capacity > SIZE_MAX / sizeof(String_Map_Entry)){
+            fprintf(stderr, "[ERROR] String_Map is too large to grow\n");
+            return false;
+        }
+        if(__internal_map_rehash(map, capacity) == false) return false;
+        slot = __internal_map_find_free(map, hash);
+    }
+
+    String_View stored = key;
+    if(map->owned_keys){
+        char* copy = (char*)malloc(key.size + 1);
+        if(copy == NULL){
+            fprintf(stderr, "[ERROR] Could not allocate memory\n");
+            return false;
+        }
+        memcpy(copy, key.string, key.size);
+        copy[key.size] = '\0';
+        stored = sv_from_parts(copy, key.size);
+    }
+
+    if(map->ctrl[slot] == STRING_MAP_EMPTY) map->growth_left--;
+
+    map->ctrl[slot] = (int8_t)__internal_map_h2(hash);
+    map->entries[slot].key = stored;
+    map->entries[slot].value = value;
+    map->size++;
+
+    return true;
+}
+
+void** string_map_get(String_Map* map, String_View key){
+    if(map == NULL || map->size == 0) return NULL;
+
+    size_t slot = __internal_map_find(map, key, sv_hash(key));
+    if(slot == SIZE_MAX) return NULL;
+
+    return &map->entries[slot].value;
+}
+
+bool string_map_contains(String_Map* map, String_View key){
+    return string_map_get(map, key) != NULL;
+}
+
+bool string_map_erase(String_Map* map, String_View key){
+    if(map == NULL || map->size == 0) return false;
+
+    size_t slot = __internal_map_find(map, key, sv_hash(key));
+    if(slot == SIZE_MAX) return false;
+
+    if(map->owned_keys) free((char*)map->entries[slot].key.string);
+
+    //If the group still has an empty slot no probe ever went past it, so the slot can be empty again
+    const int8_t* group = map->ctrl + (slot / STRING_MAP_GROUP_SIZE) * STRING_MAP_GROUP_SIZE;
+    if(__internal_map_match(group, STRING_MAP_EMPTY) != 0){
+        map->ctrl[slot] = STRING_MAP_EMPTY;
+        map->growth_left++;
+    }
+    else{
+        map->ctrl[slot] = STRING_MAP_DELETED;
+    }
+
+    map->size--;
+    return true;
+}
+
+bool string_map_next(String_Map* map, size_t* iterator, String_Map_Entry** entry){
+    if(map == NULL || iterator == NULL || entry == NULL) return false;
+
+    while(*iterator < map->capacity){
+        size_t slot = (*iterator)++;
+        if(__internal_map_is_full(map->ctrl[slot])){
+            *entry = &map->entries[slot];
+            return true;
+        }
+    }
+
+    return false;
+}
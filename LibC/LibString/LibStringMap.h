@@ -0,0 +1,64 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include "LibStringView.h"
+
+#define STRING_MAP_GROUP_SIZE 16
+
+typedef struct
+{
+    String_View key;
+    void* value;
+}String_Map_Entry;
+
+//Open addressing hash map in the style of Swiss tables: one control byte per slot holds
+//7 bits of the hash, and lookups scan a group of 16 control bytes with one SIMD compare.
+//Keys are borrowed views unless owned_keys is set, in which case the map keeps its own copy.
+typedef struct
+{
+    int8_t* ctrl;
+    String_Map_Entry* entries;
+    size_t capacity;
+    size_t size;
+    size_t growth_left;
+    bool owned_keys;
+}String_Map;
+
+bool string_map_init(String_Map* map, bool owned_keys);
+void string_map_free(String_Map* map);
+bool string_map_reserve(String_Map* map, size_t count);
+
+//Inserts key or replaces its value
+bool string_map_put(String_Map* map, String_View key, void* value);
+//Address of the value stored for key, NULL when key is missing
+void** string_map_get(String_Map* map, String_View key);
+bool string_map_contains(String_Map* map, String_View key);
+bool string_map_erase(String_Map* map, String_View key);
+
+//Start with *iterator = 0, returns false once every entry has been visited
+bool string_map_next(String_Map* map, size_t* iterator, String_Map_Entry** entry);
@@ -24,6 +24,346 @@
 
 #include "LibStringView.h"
 #include <stdio.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    #include <immintrin.h>
+    #define LIB_SV_X86
+#endif
+
+///
+///Search kernels
+///
+///Vector loops only run while a whole block fits inside the view and the
+///remainder is handled byte by byte, so no load ever touches memory past
+///sv.string + sv.size even when the view ends right before an unmapped page.
+///
+
+typedef struct
+{
+    bool (*equal)(const char* a, const char* b, size_t size);
+    size_t (*find_char)(const char* string, size_t size, char c);
+    size_t (*find_any)(const char* string, size_t size, const char* set, size_t set_size);
+    size_t (*find)(const char* string, size_t size, const char* needle, size_t needle_size);
+    size_t (*leading_space)(const char* string, size_t size);
+    size_t (*trailing_space)(const char* string, size_t size);
+}Sv_Kernels;
+
+//isspace() of the C locale: '\t' '\n' '\v' '\f' '\r' and ' '
+static const uint8_t sv_space_class[256] = {
+    ['\t'] = 1, ['\n'] = 1, ['\v'] = 1, ['\f'] = 1, ['\r'] = 1, [' '] = 1,
+};
+
+static size_t __internal_sv_leading_space_scalar(const char* string, size_t size){
+    size_t i = 0;
+    while(i < size && sv_space_class[(uint8_t)string[i]]) i++;
+    return i;
+}
+
+static size_t __internal_sv_trailing_space_scalar(const char* string, size_t size){
+    size_t i = size;
+    while(i > 0 && sv_space_class[(uint8_t)string[i - 1]]) i--;
+    return size - i;
+}
+
+static bool __internal_sv_equal_scalar(const char* a, const char* b, size_t size){
+    return memcmp(a, b, size) == 0;
+}
+
+static size_t __internal_sv_find_char_scalar(const char* string, size_t size, char c){
+    const char* found = (const char*)memchr(string, c, size);
+    return found != NULL ? (size_t)(found - string) : SV_NPOS;
+}
+
+static size_t __internal_sv_find_any_scalar(const char* string, size_t size, const char* set, size_t set_size){
+    uint8_t table[256] = {0};
+    for(size_t i = 0; i < set_size; i++) table[(uint8_t)set[i]] = 1;
+
+    for(size_t i = 0; i < size; i++){
+        if(table[(uint8_t)string[i]]) return i;
+    }
+
+    return SV_NPOS;
+}
+
+static size_t __internal_sv_find_scalar(const char* string, size_t size, const char* needle, size_t needle_size){
+    size_t i = 0;
+
+    while(i + needle_size <= size){
+        const char* first = (const char*)memchr(string + i, needle[0], size - needle_size - i + 1);
+        if(first == NULL) return SV_NPOS;
+
+        i = (size_t)(first - string);
+        if(memcmp(string + i, needle, needle_size) == 0) return i;
+        i++;
+    }
+
+    return SV_NPOS;
+}
+
+#ifdef LIB_SV_X86
+__attribute__((target("sse2")))
+static bool __internal_sv_equal_sse2(const char* a, const char* b, size_t size){
+    size_t i = 0;
+
+    for(; i + 16 <= size; i += 16){
+        __m128i block_a = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i block_b = _mm_loadu_si128((const __m128i*)(b + i));
+        if(_mm_movemask_epi8(_mm_cmpeq_epi8(block_a, block_b)) != 0xFFFF) return false;
+    }
+
+    return memcmp(a + i, b + i, size - i) == 0;
+}
+
+__attribute__((target("sse2")))
+static size_t __internal_sv_find_char_sse2(const char* string, size_t size, char c){
+    __m128i pattern = _mm_set1_epi8(c);
+    size_t i = 0;
+
+    for(; i + 16 <= size; i += 16){
+        __m128i block = _mm_loadu_si128((const __m128i*)(string + i));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern));
+        if(mask != 0) return i + (size_t)__builtin_ctz((unsigned)mask);
+    }
+
+    for(; i < size; i++){
+        if(string[i] == c) return i;
+    }
+
+    return SV_NPOS;
+}
+
+__attribute__((target("sse2")))
+static size_t __internal_sv_find_any_sse2(const char* string, size_t size, const char* set, size_t set_size){
+    //Each set byte costs a compare per block, past a handful the lookup table wins
+    if(set_size > 16) return __internal_sv_find_any_scalar(string, size, set, set_size);
+
+    __m128i patterns[16];
+    for(size_t j = 0; j < set_size; j++) patterns[j] = _mm_set1_epi8(set[j]);
+
+    size_t i = 0;
+    for(; i + 16 <= size; i += 16){
+        __m128i block = _mm_loadu_si128((const __m128i*)(string + i));
+        __m128i hits = _mm_setzero_si128();
+
+        for(size_t j = 0; j < set_size; j++){
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, patterns[j]));
+        }
+
+        int mask = _mm_movemask_epi8(hits);
+        if(mask != 0) return i + (size_t)__builtin_ctz((unsigned)mask);
+    }
+
+    size_t tail = __internal_sv_find_any_scalar(string + i, size - i, set, set_size);
+    return tail == SV_NPOS ? SV_NPOS : i + tail;
+}
+
+__attribute__((target("sse2")))
+static size_t __internal_sv_find_sse2(const char* string, size_t size, const char* needle, size_t needle_size){
+    //Match first and last needle byte for 16 positions at once, verify candidates with memcmp
+    __m128i first = _mm_set1_epi8(needle[0]);
+    __m128i last = _mm_set1_epi8(needle[needle_size - 1]);
+    size_t i = 0;
+
+    for(; i + needle_size - 1 + 16 <= size; i += 16){
+        __m128i block_first = _mm_loadu_si128((const __m128i*)(string + i));
+        __m128i block_last = _mm_loadu_si128((const __m128i*)(string + i + needle_size - 1));
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_last, last)));
+
+        while(mask != 0){
+            size_t candidate = i + (size_t)__builtin_ctz(mask);
+            if(memcmp(string + candidate + 1, needle + 1, needle_size - 2) == 0) return candidate;
+            mask &= mask - 1;
+        }
+    }
+
+    size_t tail = __internal_sv_find_scalar(string + i, size - i, needle, needle_size);
+    return tail == SV_NPOS ? SV_NPOS : i + tail;
+}
+
+__attribute__((target("avx2")))
+static bool __internal_sv_equal_avx2(const char* a, const char* b, size_t size){
+    size_t i = 0;
+
+    for(; i + 32 <= size; i += 32){
+        __m256i block_a = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i block_b = _mm256_loadu_si256((const __m256i*)(b + i));
+        if((unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block_a, block_b)) != 0xFFFFFFFFu) return false;
+    }
+
+    //The SSE2 tails are legacy encoded, entering them with dirty upper YMM halves costs a
+    //state transition that dwarfs a short view, so every AVX2 kernel clears them first
+    _mm256_zeroupper();
+    return __internal_sv_equal_sse2(a + i, b + i, size - i);
+}
+
+__attribute__((target("avx2")))
+static size_t __internal_sv_find_char_avx2(const char* string, size_t size, char c){
+    __m256i pattern = _mm256_set1_epi8(c);
+    size_t i = 0;
+
+    for(; i + 32 <= size; i += 32){
+        __m256i block = _mm256_loadu_si256((const __m256i*)(string + i));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern));
+        if(mask != 0) return i + (size_t)__builtin_ctz(mask);
+    }
+
+    _mm256_zeroupper();
+    size_t tail = __internal_sv_find_char_sse2(string + i, size - i, c);
+    return tail == SV_NPOS ? SV_NPOS : i + tail;
+}
+
+__attribute__((target("avx2")))
+static size_t __internal_sv_find_any_avx2(const char* string, size_t size, const char* set, size_t set_size){
+    if(set_size > 16) return __internal_sv_find_any_scalar(string, size, set, set_size);
+
+    __m256i patterns[16];
+    for(size_t j = 0; j < set_size; j++) patterns[j] = _mm256_set1_epi8(set[j]);
+
+    size_t i = 0;
+    for(; i + 32 <= size; i += 32){
+        __m256i block = _mm256_loadu_si256((const __m256i*)(string + i));
+        __m256i hits = _mm256_setzero_si256();
+
+        for(size_t j = 0; j < set_size; j++){
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, patterns[j]));
+        }
+
+        unsigned mask = (unsigned)_mm256_movemask_epi8(hits);
+        if(mask != 0) return i + (size_t)__builtin_ctz(mask);
+    }
+
+    _mm256_zeroupper();
+    size_t tail = __internal_sv_find_any_sse2(string + i, size - i, set, set_size);
+    return tail == SV_NPOS ? SV_NPOS : i + tail;
+}
+
+__attribute__((target("avx2")))
+static size_t __internal_sv_find_avx2(const char* string, size_t size, const char* needle, size_t needle_size){
+    __m256i first = _mm256_set1_epi8(needle[0]);
+    __m256i last = _mm256_set1_epi8(needle[needle_size - 1]);
+    size_t i = 0;
+
+    for(; i + needle_size - 1 + 32 <= size; i += 32){
+        __m256i block_first = _mm256_loadu_si256((const __m256i*)(string + i));
+        __m256i block_last = _mm256_loadu_si256((const __m256i*)(string + i + needle_size - 1));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(block_first, first), _mm256_cmpeq_epi8(block_last, last)));
+
+        while(mask != 0){
+            size_t candidate = i + (size_t)__builtin_ctz(mask);
+            if(memcmp(string + candidate + 1, needle + 1, needle_size - 2) == 0) return candidate;
+            mask &= mask - 1;
+        }
+    }
+
+    _mm256_zeroupper();
+    size_t tail = __internal_sv_find_sse2(string + i, size - i, needle, needle_size);
+    return tail == SV_NPOS ? SV_NPOS : i + tail;
+}
+
+//Whitespace is ' ' or a byte in '\t'..'\r', the range test is (byte - '\t') <= 4 unsigned
+__attribute__((target("sse2")))
+static inline unsigned __internal_sv_space_mask_sse2(__m128i block){
+    __m128i shifted = _mm_sub_epi8(block, _mm_set1_epi8('\t'));
+    __m128i in_range = _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(4)), shifted);
+    __m128i blank = _mm_cmpeq_epi8(block, _mm_set1_epi8(' '));
+    return (unsigned)_mm_movemask_epi8(_mm_or_si128(in_range, blank));
+}
+
+__attribute__((target("sse2")))
+static size_t __internal_sv_leading_space_sse2(const char* string, size_t size){
+    size_t i = 0;
+
+    for(; i + 16 <= size; i += 16){
+        unsigned other = ~__internal_sv_space_mask_sse2(_mm_loadu_si128((const __m128i*)(string + i))) & 0xFFFFu;
+        if(other != 0) return i + (size_t)__builtin_ctz(other);
+    }
+
+    return i + __internal_sv_leading_space_scalar(string + i, size - i);
+}
+
+__attribute__((target("sse2")))
+static size_t __internal_sv_trailing_space_sse2(const char* string, size_t size){
+    size_t end = size;
+
+    for(; end >= 16; end -= 16){
+        unsigned other = ~__internal_sv_space_mask_sse2(_mm_loadu_si128((const __m128i*)(string + end - 16))) & 0xFFFFu;
+        if(other != 0) return size - (end - 16 + 32 - (size_t)__builtin_clz(other));
+    }
+
+    return size - end + __internal_sv_trailing_space_scalar(string, end);
+}
+
+__attribute__((target("avx2")))
+static inline unsigned __internal_sv_space_mask_avx2(__m256i block){
+    __m256i shifted = _mm256_sub_epi8(block, _mm256_set1_epi8('\t'));
+    __m256i in_range = _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, _mm256_set1_epi8(4)), shifted);
+    __m256i blank = _mm256_cmpeq_epi8(block, _mm256_set1_epi8(' '));
+    return (unsigned)_mm256_movemask_epi8(_mm256_or_si256(in_range, blank));
+}
+
+__attribute__((target("avx2")))
+static size_t __internal_sv_leading_space_avx2(const char* string, size_t size){
+    size_t i = 0;
+
+    for(; i + 32 <= size; i += 32){
+        unsigned other = ~__internal_sv_space_mask_avx2(_mm256_loadu_si256((const __m256i*)(string + i)));
+        if(other != 0) return i + (size_t)__builtin_ctz(other);
+    }
+
+    _mm256_zeroupper();
+    return i + __internal_sv_leading_space_sse2(string + i, size - i);
+}
+
+__attribute__((target("avx2")))
+static size_t __internal_sv_trailing_space_avx2(const char* string, size_t size){
+    size_t end = size;
+
+    for(; end >= 32; end -= 32){
+        unsigned other = ~__internal_sv_space_mask_avx2(_mm256_loadu_si256((const __m256i*)(string + end - 32)));
+        if(other != 0) return size - (end - 32 + 32 - (size_t)__builtin_clz(other));
+    }
+
+    _mm256_zeroupper();
+    return size - end + __internal_sv_trailing_space_sse2(string, end);
+}
+#endif
+
+static const Sv_Kernels* __internal_sv_kernels(void){
+    static const Sv_Kernels scalar = {
+        __internal_sv_equal_scalar, __internal_sv_find_char_scalar,
+        __internal_sv_find_any_scalar, __internal_sv_find_scalar,
+        __internal_sv_leading_space_scalar, __internal_sv_trailing_space_scalar,
+    };
+#ifdef LIB_SV_X86
+    static const Sv_Kernels sse2 = {
+        __internal_sv_equal_sse2, __internal_sv_find_char_sse2,
+        __internal_sv_find_any_sse2, __internal_sv_find_sse2,
+        __internal_sv_leading_space_sse2, __internal_sv_trailing_space_sse2,
+    };
+    static const Sv_Kernels avx2 = {
+        __internal_sv_equal_avx2, __internal_sv_find_char_avx2,
+        __internal_sv_find_any_avx2, __internal_sv_find_avx2,
+        __internal_sv_leading_space_avx2, __internal_sv_trailing_space_avx2,
+    };
+#endif
+
+    //Every thread resolves to the same table, a racing first call just stores it twice
+    static _Atomic(const Sv_Kernels*) selected = NULL;
+    const Sv_Kernels* resolved = atomic_load_explicit(&selected, memory_order_relaxed);
+    if(resolved != NULL) return resolved;
+
+    const Sv_Kernels* kernels = &scalar;
+#ifdef LIB_SV_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")) kernels = &avx2;
+    else if(__builtin_cpu_supports("sse2")) kernels = &sse2;
+#endif
+
+    atomic_store_explicit(&selected, kernels, memory_order_relaxed);
+    return kernels;
+}
 
 String_View sv_append(const char* string){
     String_View string_to_append = {0};
@@ -44,12 +384,18 @@ char* sv_to_cstr(String_View sv){
     char* sv_buffer = (char*)calloc(sv.size + 1, sizeof(char));
     if(sv_buffer == NULL) return NULL;
 
-    strcpy(sv_buffer, sv.string);
+    memcpy(sv_buffer, sv.string, sv.size);
     sv_buffer[sv.size] = '\0';
     
     return sv_buffer;
 }
 
+char* sv_to_cstr_arena(Arena* arena, String_View sv){
+    if(arena == NULL) return sv_to_cstr(sv);
+
+    return arena_strndup(arena, sv.string, sv.size);
+}
+
 bool sv_cmp(String_View sv, String_View sv2){
 
     //Avoid wasting time on compare
@@ -57,26 +403,225 @@ bool sv_cmp(String_View sv, String_View sv2){
         return false;
     }
 
-    for(size_t i = 0; i < sv.size; i++){
-        if(sv.string[i] != sv2.string[i])
-            return false;
+    if(sv.string == sv2.string || sv.size == 0){
+        return true;
     }
-    
-    return true;
+
+    return __internal_sv_kernels()->equal(sv.string, sv2.string, sv.size);
 }
 
 String_View sv_trim_left(String_View sv){
-    size_t space_counter = 0;
+    if(sv.size == 0) return sv;
+
+    size_t space_counter = __internal_sv_kernels()->leading_space(sv.string, sv.size);
+
+    return sv_from_parts(sv.string + space_counter, sv.size - space_counter);
+}
+
+bool sv_starts_with(String_View sv, String_View prefix){
+    if(prefix.size > sv.size) return false;
+    if(prefix.size == 0) return true;
+
+    return __internal_sv_kernels()->equal(sv.string, prefix.string, prefix.size);
+}
+
+bool sv_ends_with(String_View sv, String_View suffix){
+    if(suffix.size > sv.size) return false;
+    if(suffix.size == 0) return true;
+
+    return __internal_sv_kernels()->equal(sv.string + sv.size - suffix.size, suffix.string, suffix.size);
+}
+
+size_t sv_find_char(String_View sv, char c){
+    if(sv.size == 0) return SV_NPOS;
+
+    return __internal_sv_kernels()->find_char(sv.string, sv.size, c);
+}
+
+size_t sv_find_any(String_View sv, String_View set){
+    if(sv.size == 0 || set.size == 0) return SV_NPOS;
+    if(set.size == 1) return sv_find_char(sv, set.string[0]);
+
+    return __internal_sv_kernels()->find_any(sv.string, sv.size, set.string, set.size);
+}
+
+size_t sv_find(String_View sv, String_View needle){
+    if(needle.size == 0) return 0;
+    if(needle.size > sv.size) return SV_NPOS;
+    if(needle.size == 1) return sv_find_char(sv, needle.string[0]);
+
+    return __internal_sv_kernels()->find(sv.string, sv.size, needle.string, needle.size);
+}
+
+String_View sv_from_parts(const char* string, size_t size){
+    String_View sv = {0};
+
+    sv.string = string;
+    sv.size = size;
+
+    return sv;
+}
+
+String_View sv_trim_right(String_View sv){
+    if(sv.size == 0) return sv;
+
+    size_t space_counter = __internal_sv_kernels()->trailing_space(sv.string, sv.size);
+
+    return sv_from_parts(sv.string, sv.size - space_counter);
+}
+
+String_View sv_trim(String_View sv){
+    return sv_trim_right(sv_trim_left(sv));
+}
+
+String_View sv_chop_left(String_View* sv, size_t n){
+    if(n > sv->size) n = sv->size;
+
+    String_View chunk = sv_from_parts(sv->string, n);
+    sv->string += n;
+    sv->size -= n;
+
+    return chunk;
+}
+
+String_View sv_chop_right(String_View* sv, size_t n){
+    if(n > sv->size) n = sv->size;
+
+    String_View chunk = sv_from_parts(sv->string + sv->size - n, n);
+    sv->size -= n;
+
+    return chunk;
+}
+
+//Splits at index (SV_NPOS means the whole view) and drops separator_size bytes after it
+static String_View __internal_sv_chop_at(String_View* sv, size_t index, size_t separator_size){
+    if(index == SV_NPOS){
+        String_View chunk = *sv;
+        sv->string += sv->size;
+        sv->size = 0;
+        return chunk;
+    }
 
-    for(size_t i = 0; i < sv.size; i++){
+    String_View chunk = sv_from_parts(sv->string, index);
+    sv->string += index + separator_size;
+    sv->size -= index + separator_size;
+
+    return chunk;
+}
+
+static size_t __internal_sv_find_space(String_View sv){
+    static const char whitespace[] = " \t\n\v\f\r";
+    return sv_find_any(sv, sv_from_parts(whitespace, sizeof(whitespace) - 1));
+}
+
+String_View sv_chop_by_delim(String_View* sv, char delim){
+    return __internal_sv_chop_at(sv, sv_find_char(*sv, delim), 1);
+}
+
+String_View sv_chop_by_set(String_View* sv, String_View set){
+    return __internal_sv_chop_at(sv, sv_find_any(*sv, set), 1);
+}
+
+String_View sv_chop_by_whitespace(String_View* sv){
+    *sv = sv_trim_left(*sv);
+    return __internal_sv_chop_at(sv, __internal_sv_find_space(*sv), 1);
+}
+
+String_View sv_chop_line(String_View* sv){
+    String_View line = __internal_sv_chop_at(sv, sv_find_char(*sv, '\n'), 1);
+
+    if(line.size > 0 && line.string[line.size - 1] == '\r'){
+        line.size--;
+    }
+
+    return line;
+}
+
+Sv_Split sv_split(String_View sv){
+    Sv_Split split = {0};
+
+    split.rest = sv;
+    split.done = false;
+
+    return split;
+}
+
+static bool __internal_sv_split_at(Sv_Split* split, size_t index, String_View* token){
+    if(split->done) return false;
+
+    if(index == SV_NPOS) split->done = true;
+    *token = __internal_sv_chop_at(&split->rest, index, 1);
+
+    return true;
+}
+
+bool sv_split_next(Sv_Split* split, char delim, String_View* token){
+    return __internal_sv_split_at(split, sv_find_char(split->rest, delim), token);
+}
+
+bool sv_split_next_set(Sv_Split* split, String_View set, String_View* token){
+    return __internal_sv_split_at(split, sv_find_any(split->rest, set), token);
+}
+
+bool sv_split_next_whitespace(Sv_Split* split, String_View* token){
+    //Runs of whitespace separate tokens, there are no empty tokens
+    split->rest = sv_trim_left(split->rest);
+    if(split->rest.size == 0) split->done = true;
+
+    return __internal_sv_split_at(split, __internal_sv_find_space(split->rest), token);
+}
+
+bool sv_split_next_line(Sv_Split* split, String_View* line){
+    //A final newline terminates the last line instead of starting an empty one
+    if(split->rest.size == 0) split->done = true;
+
+    if(__internal_sv_split_at(split, sv_find_char(split->rest, '\n'), line) == false) return false;
+
+    if(line->size > 0 && line->string[line->size - 1] == '\r'){
+        line->size--;
+    }
+
+    return true;
+}
+
+static inline uint64_t __internal_sv_hash_mix(uint64_t a, uint64_t b){
+    uint64_t high;
+    uint64_t low = __internal_sv_mul_128(a, b, &high);
+    return low ^ high;
+}
+
+static inline uint64_t __internal_sv_read64(const char* data){
+    uint64_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+uint64_t sv_hash(String_View sv){
+    const uint64_t k0 = 0xA0761D6478BD642Full;
+    const uint64_t k1 = 0xE7037ED1A0B428DBull;
+    const uint64_t k2 = 0x8EBC6AF09C88C6E3ull;
+
+    const char* data = sv.string;
+    size_t size = sv.size;
+    uint64_t hash = k0 ^ (uint64_t)size;
+
+    while(size >= 16){
+        hash = __internal_sv_hash_mix(__internal_sv_read64(data) ^ k1, __internal_sv_read64(data + 8) ^ hash);
+        data += 16;
+        size -= 16;
+    }
+
+    if(size >= 8){
+        hash = __internal_sv_hash_mix(__internal_sv_read64(data) ^ k1, hash ^ k2);
+        data += 8;
+        size -= 8;
+    }
 
-        if(isspace(sv.string[i]) != 0)
-            space_counter++;
-        
-        if(isspace(sv.string[i]) == 0)
-            break;
-        
+    if(size > 0){
+        uint64_t tail = 0;
+        memcpy(&tail, data, size);
+        hash = __internal_sv_hash_mix(tail ^ k2, hash ^ k1);
     }
 
-    return sv_append(&sv.string[space_counter]);
+    return __internal_sv_hash_mix(hash ^ k0, (uint64_t)sv.size ^ k1);
 }
\ No newline at end of file
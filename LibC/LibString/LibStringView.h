@@ -28,6 +28,9 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <ctype.h>
+#include <stdint.h>
+
+#include "../LibArena/LibArena.h"
 
 typedef struct
 {
@@ -35,8 +38,75 @@ typedef struct
     size_t size;
 }String_View;
 
+typedef struct
+{
+    String_View rest;
+    bool done;
+}Sv_Split;
+
 
 String_View sv_append(const char* string);
 char* sv_to_cstr(String_View sv);
+char* sv_to_cstr_arena(Arena* arena, String_View sv);
 bool sv_cmp(String_View sv, String_View sv2);
-String_View sv_trim_left(String_View sv);
\ No newline at end of file
+String_View sv_trim_left(String_View sv);
+
+//Returned by the search functions when nothing is found
+#define SV_NPOS ((size_t)-1)
+
+bool sv_starts_with(String_View sv, String_View prefix);
+bool sv_ends_with(String_View sv, String_View suffix);
+size_t sv_find_char(String_View sv, char c);
+size_t sv_find_any(String_View sv, String_View set);
+size_t sv_find(String_View sv, String_View needle);
+
+String_View sv_from_parts(const char* string, size_t size);
+String_View sv_trim_right(String_View sv);
+String_View sv_trim(String_View sv);
+
+//The sv_chop_* functions return a sub-view and advance sv past it, nothing is copied
+String_View sv_chop_left(String_View* sv, size_t n);
+String_View sv_chop_right(String_View* sv, size_t n);
+String_View sv_chop_by_delim(String_View* sv, char delim);
+String_View sv_chop_by_set(String_View* sv, String_View set);
+String_View sv_chop_by_whitespace(String_View* sv);
+String_View sv_chop_line(String_View* sv);
+
+//Iterator form: unlike chop it reports a trailing empty field ("a," splits into "a" and "")
+Sv_Split sv_split(String_View sv);
+bool sv_split_next(Sv_Split* split, char delim, String_View* token);
+bool sv_split_next_set(Sv_Split* split, String_View set, String_View* token);
+bool sv_split_next_whitespace(Sv_Split* split, String_View* token);
+bool sv_split_next_line(Sv_Split* split, String_View* line);
+
+//Fast non-cryptographic hash, not suitable against adversarial keys
+uint64_t sv_hash(String_View sv);
+#if !defined(__SIZEOF_INT128__) && defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+//Full 64x64 bit product: returns the low half and stores the high half, shared by sv_hash and the number parser
+static inline uint64_t __internal_sv_mul_128(uint64_t a, uint64_t b, uint64_t* high){
+#if defined(__SIZEOF_INT128__)
+    __extension__ unsigned __int128 product = (unsigned __int128)a * b;
+    *high = (uint64_t)(product >> 64);
+    return (uint64_t)product;
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return _umul128(a, b, high);
+#else
+    //Schoolbook multiply on 32 bit halves, the middle sum cannot overflow 64 bits
+    uint64_t a_low = (uint32_t)a;
+    uint64_t a_high = a >> 32;
+    uint64_t b_low = (uint32_t)b;
+    uint64_t b_high = b >> 32;
+
+    uint64_t low_low = a_low * b_low;
+    uint64_t low_high = a_low * b_high;
+    uint64_t high_low = a_high * b_low;
+    uint64_t high_high = a_high * b_high;
+
+    uint64_t middle = (low_low >> 32) + (uint32_t)low_high + (uint32_t)high_low;
+    *high = high_high + (low_high >> 32) + (high_low >> 32) + (middle >> 32);
+    return (middle << 32) | (uint32_t)low_low;
+#endif
+}
@@ -0,0 +1,394 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#include "LibTerminalFrame.h"
+
+#ifdef __linux__
+    #include <errno.h>
+    #include <sys/ioctl.h>
+    #include <unistd.h>
+#endif
+
+static const Terminal_Cell __internal_blank_cell = {' ', TERMINAL_COLOR_DEFAULT, TERMINAL_COLOR_DEFAULT, TERMINAL_ATTR_NONE};
+
+static inline bool __internal_cell_equal(const Terminal_Cell* a, const Terminal_Cell* b){
+    return a->codepoint == b->codepoint && a->fg == b->fg && a->bg == b->bg && a->attr == b->attr;
+}
+
+static inline bool __internal_style_equal(const Terminal_Cell* a, const Terminal_Cell* b){
+    return a->fg == b->fg && a->bg == b->bg && a->attr == b->attr;
+}
+
+static void __internal_fill_blank(Terminal_Cell* cells, size_t count){
+    for(size_t i = 0; i < count; i++){
+        cells[i] = __internal_blank_cell;
+    }
+}
+
+int terminal_size(size_t* width, size_t* height){
+    if(width == NULL || height == NULL) return 1;
+
+#ifdef __linux__
+    struct winsize size;
+    if(ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) != 0 || size.ws_col == 0 || size.ws_row == 0) return 1;
+
+    *width = size.ws_col;
+    *height = size.ws_row;
+    return 0;
+
+#elif __WIN32
+    CONSOLE_SCREEN_BUFFER_INFO info;
+    if(!GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info)) return 1;
+
+    *width = (size_t)(info.srWindow.Right - info.srWindow.Left + 1);
+    *height = (size_t)(info.srWindow.Bottom - info.srWindow.Top + 1);
+    return 0;
+
+#endif
+}
+
+int terminal_frame_init(Terminal_Frame* frame, size_t width, size_t height){
+    if(frame == NULL) return 1;
+
+    frame->cells = NULL;
+    frame->previous = NULL;
+    frame->width = 0;
+    frame->height = 0;
+    frame->full_redraw = true;
+    sb_init(&frame->output);
+
+    return terminal_frame_resize(frame, width, height);
+}
+
+int terminal_frame_resize(Terminal_Frame* frame, size_t width, size_t height){
+    if(frame == NULL || width == 0 || height == 0) return 1;
+
+    if(width > SIZE_MAX / height / sizeof(Terminal_Cell)){
+        fprintf(stderr, "[ERROR] Frame of %zux%zu cells is too large\n", width, height);
+        return 1;
+    }
+
+    size_t count = width * height;
+    Terminal_Cell* cells = (Terminal_Cell*)malloc(count * sizeof(Terminal_Cell));
+    Terminal_Cell* previous = (Terminal_Cell*)malloc(count * sizeof(Terminal_Cell));
+
+    if(cells == NULL || previous == NULL){
+        fprintf(stderr, "[ERROR] Could not allocate memory\n");
+        free(cells);
+        free(previous);
+        return 1;
+    }
+
+    //Keep what was already drawn in the part that still fits
+    __internal_fill_blank(cells, count);
+    if(frame->cells != NULL){
+        size_t rows = frame->height < height ? frame->height : height;
+        size_t columns = frame->width < width ? frame->width : width;
+
+        for(size_t y = 0; y < rows; y++){
+            memcpy(&cells[y * width], &frame->cells[y * frame->width], columns * sizeof(Terminal_Cell));
+        }
+    }
+
+    free(frame->cells);
+    free(frame->previous);
+
+    frame->cells = cells;
+    frame->previous = previous;
+    frame->width = width;
+    frame->height = height;
+    frame->full_redraw = true;
+
+    return 0;
+}
+
+void terminal_frame_free(Terminal_Frame* frame){
+    if(frame == NULL) return;
+
+    free(frame->cells);
+    free(frame->previous);
+    sb_free(&frame->output);
+
+    frame->cells = NULL;
+    frame->previous = NULL;
+    frame->width = 0;
+    frame->height = 0;
+}
+
+void terminal_frame_invalidate(Terminal_Frame* frame){
+    if(frame == NULL) return;
+    frame->full_redraw = true;
+}
+
+void terminal_frame_clear(Terminal_Frame* frame){
+    if(frame == NULL || frame->cells == NULL) return;
+    __internal_fill_blank(frame->cells, frame->width * frame->height);
+}
+
+void terminal_frame_put(Terminal_Frame* frame, size_t x, size_t y, uint32_t codepoint, uint16_t fg, uint16_t bg, uint8_t attr){
+    if(frame == NULL || x >= frame->width || y >= frame->height) return;
+
+    Terminal_Cell* cell = &frame->cells[y * frame->width + x];
+    cell->codepoint = codepoint;
+    cell->fg = fg;
+    cell->bg = bg;
+    cell->attr = attr;
+}
+
+void terminal_frame_fill(Terminal_Frame* frame, size_t x, size_t y, size_t width, size_t height, uint32_t codepoint, uint16_t fg, uint16_t bg, uint8_t attr){
+    if(frame == NULL || x >= frame->width || y >= frame->height) return;
+
+    if(width > frame->width - x) width = frame->width - x;
+    if(height > frame->height - y) height = frame->height - y;
+
+    Terminal_Cell cell = {codepoint, fg, bg, attr};
+    for(size_t row = y; row < y + height; row++){
+        Terminal_Cell* line = &frame->cells[row * frame->width];
+        for(size_t column = x; column < x + width; column++){
+            line[column] = cell;
+        }
+    }
+}
+
+//Returns the number of bytes read, malformed sequences decode as U+FFFD one byte at a time
+static size_t __internal_utf8_decode(const unsigned char* p, size_t size, uint32_t* codepoint){
+    if(p[0] < 0x80){
+        *codepoint = p[0];
+        return 1;
+    }
+
+    size_t length;
+    uint32_t value;
+    uint32_t minimum;
+
+    if((p[0] & 0xE0) == 0xC0){ length = 2; value = p[0] & 0x1F; minimum = 0x80; }
+    else if((p[0] & 0xF0) == 0xE0){ length = 3; value = p[0] & 0x0F; minimum = 0x800; }
+    else if((p[0] & 0xF8) == 0xF0){ length = 4; value = p[0] & 0x07; minimum = 0x10000; }
+    else{
+        *codepoint = 0xFFFD;
+        return 1;
+    }
+
+    if(length > size){
+        *codepoint = 0xFFFD;
+        return 1;
+    }
+
+    for(size_t i = 1; i < length; i++){
+        if((p[i] & 0xC0) != 0x80){
+            *codepoint = 0xFFFD;
+            return 1;
+        }
+        value = (value << 6) | (p[i] & 0x3F);
+    }
+
+    if(value < minimum || value > 0x10FFFF || (value >= 0xD800 && value <= 0xDFFF)) value = 0xFFFD;
+
+    *codepoint = value;
+    return length;
+}
+
+size_t terminal_frame_text(Terminal_Frame* frame, size_t x, size_t y, String_View text, uint16_t fg, uint16_t bg, uint8_t attr){
+    if(frame == NULL || text.string == NULL || y >= frame->height) return 0;
+
+    const unsigned char* p = (const unsigned char*)text.string;
+    size_t remaining = text.size;
+    size_t written = 0;
+
+    while(remaining > 0 && x < frame->width){
+        uint32_t codepoint;
+        size_t length = __internal_utf8_decode(p, remaining, &codepoint);
+
+        //Control characters would move the real cursor and desync the diff
+        if(codepoint < 0x20 || codepoint == 0x7F) codepoint = ' ';
+
+        terminal_frame_put(frame, x, y, codepoint, fg, bg, attr);
+
+        p += length;
+        remaining -= length;
+        x++;
+        written++;
+    }
+
+    return written;
+}
+
+static void __internal_append_color(String_Builder* output, uint16_t color, int base, int bright_base, int extended){
+    if(color == TERMINAL_COLOR_DEFAULT) return;
+
+    if(color < 8) sb_appendf(output, ";%d", base + color);
+    else if(color < 16) sb_appendf(output, ";%d", bright_base + color - 8);
+    else sb_appendf(output, ";%d;5;%u", extended, (unsigned)(color & 0xFF));
+}
+
+static void __internal_append_style(String_Builder* output, const Terminal_Cell* cell){
+    //Always start from a reset so no attribute of the previous style leaks
+    sb_append_cstr(output, "\033[0");
+
+    if(cell->attr & TERMINAL_ATTR_BOLD) sb_append_cstr(output, ";1");
+    if(cell->attr & TERMINAL_ATTR_DIM) sb_append_cstr(output, ";2");
+    if(cell->attr & TERMINAL_ATTR_ITALIC) sb_append_cstr(output, ";3");
+    if(cell->attr & TERMINAL_ATTR_UNDERLINE) sb_append_cstr(output, ";4");
+    if(cell->attr & TERMINAL_ATTR_REVERSE) sb_append_cstr(output, ";7");
+
+    __internal_append_color(output, cell->fg, 30, 90, 38);
+    __internal_append_color(output, cell->bg, 40, 100, 48);
+
+    sb_append_char(output, 'm');
+}
+
+static void __internal_append_utf8(String_Builder* output, uint32_t codepoint){
+    char buffer[4];
+    size_t length;
+
+    if(codepoint < 0x80){
+        sb_append_char(output, (char)codepoint);
+        return;
+    }
+    if(codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) codepoint = 0xFFFD;
+
+    if(codepoint < 0x800){
+        buffer[0] = (char)(0xC0 | (codepoint >> 6));
+        buffer[1] = (char)(0x80 | (codepoint & 0x3F));
+        length = 2;
+    }
+    else if(codepoint < 0x10000){
+        buffer[0] = (char)(0xE0 | (codepoint >> 12));
+        buffer[1] = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+        buffer[2] = (char)(0x80 | (codepoint & 0x3F));
+        length = 3;
+    }
+    else{
+        buffer[0] = (char)(0xF0 | (codepoint >> 18));
+        buffer[1] = (char)(0x80 | ((codepoint >> 12) & 0x3F));
+        buffer[2] = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+        buffer[3] = (char)(0x80 | (codepoint & 0x3F));
+        length = 4;
+    }
+
+    sb_append_buffer(output, buffer, length);
+}
+
+int terminal_write(const char* data, size_t size){
+#ifdef __linux__
+    //Anything still sitting in stdio has to land before the frame
+    if(fflush(stdout) == EOF) return 1;
+
+    while(size > 0){
+        ssize_t written = write(STDOUT_FILENO, data, size);
+        if(written < 0){
+            if(errno == EINTR) continue;
+            return 1;
+        }
+        data += written;
+        size -= (size_t)written;
+    }
+    return 0;
+
+#elif __WIN32
+    HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
+
+    DWORD mode = 0;
+    if(!GetConsoleMode(hConsole, &mode)){
+        return 1;
+    }
+
+    const DWORD default_mode = mode;
+    mode |= ENABLE_VIRTUAL_TERMINAL_PROCESSING;
+
+    if(!SetConsoleMode(hConsole, mode)){
+        return 1;
+    }
+
+    if(fflush(stdout) == EOF || !WriteConsoleA(hConsole, data, (DWORD)size, NULL, NULL)){
+        SetConsoleMode(hConsole, default_mode);
+        return 1;
+    }
+
+    SetConsoleMode(hConsole, default_mode);
+    return 0;
+
+#endif
+}
+
+int terminal_frame_present(Terminal_Frame* frame){
+    if(frame == NULL || frame->cells == NULL) return 1;
+
+    String_Builder* output = &frame->output;
+    sb_reset(output);
+
+    size_t count = frame->width * frame->height;
+
+    //After a clear the terminal holds blanks, so a full redraw is a diff against a blank frame
+    if(frame->full_redraw){
+        sb_append_cstr(output, "\033[0m\033[H\033[2J");
+        __internal_fill_blank(frame->previous, count);
+    }
+
+    //The cursor position is unknown until the first move of this frame
+    size_t cursor_x = SIZE_MAX;
+    size_t cursor_y = SIZE_MAX;
+    Terminal_Cell style = __internal_blank_cell;
+    bool styled = false;
+
+    for(size_t y = 0; y < frame->height; y++){
+        const Terminal_Cell* line = &frame->cells[y * frame->width];
+        const Terminal_Cell* shown = &frame->previous[y * frame->width];
+
+        for(size_t x = 0; x < frame->width; x++){
+            if(__internal_cell_equal(&line[x], &shown[x])) continue;
+
+            if(cursor_y != y || cursor_x != x){
+                sb_appendf(output, "\033[%zu;%zuH", y + 1, x + 1);
+                cursor_y = y;
+                cursor_x = x;
+            }
+
+            if(__internal_style_equal(&line[x], &style) == false){
+                __internal_append_style(output, &line[x]);
+                style = line[x];
+                styled = true;
+            }
+
+            __internal_append_utf8(output, line[x].codepoint);
+            cursor_x++;
+        }
+    }
+
+    //Leave the terminal in the default style for whoever prints next
+    if(styled && __internal_style_equal(&style, &__internal_blank_cell) == false){
+        sb_append_cstr(output, "\033[0m");
+    }
+
+    if(output->size > 0 && terminal_write(sb_data(output), output->size) != 0){
+        //What reached the terminal is unknown, start over on the next frame
+        frame->full_redraw = true;
+        return 1;
+    }
+
+    memcpy(frame->previous, frame->cells, count * sizeof(Terminal_Cell));
+    frame->full_redraw = false;
+
+    return 0;
+}
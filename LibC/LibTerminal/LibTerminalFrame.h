@@ -0,0 +1,96 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+
+#include "LibTerminal.h"
+#include "../LibString/LibStringBuilder.h"
+
+//Any value in 0-255 is a palette index, the first sixteen are the named colors
+#define TERMINAL_COLOR_DEFAULT 0xFFFF
+
+typedef enum{
+    TERMINAL_COLOR_BLACK = 0,
+    TERMINAL_COLOR_RED,
+    TERMINAL_COLOR_GREEN,
+    TERMINAL_COLOR_YELLOW,
+    TERMINAL_COLOR_BLUE,
+    TERMINAL_COLOR_MAGENTA,
+    TERMINAL_COLOR_CYAN,
+    TERMINAL_COLOR_WHITE,
+    TERMINAL_COLOR_BRIGHT_BLACK,
+    TERMINAL_COLOR_BRIGHT_RED,
+    TERMINAL_COLOR_BRIGHT_GREEN,
+    TERMINAL_COLOR_BRIGHT_YELLOW,
+    TERMINAL_COLOR_BRIGHT_BLUE,
+    TERMINAL_COLOR_BRIGHT_MAGENTA,
+    TERMINAL_COLOR_BRIGHT_CYAN,
+    TERMINAL_COLOR_BRIGHT_WHITE
+}Terminal_Color;
+
+typedef enum{
+    TERMINAL_ATTR_NONE      = 0,
+    TERMINAL_ATTR_BOLD      = 1 << 0,
+    TERMINAL_ATTR_DIM       = 1 << 1,
+    TERMINAL_ATTR_ITALIC    = 1 << 2,
+    TERMINAL_ATTR_UNDERLINE = 1 << 3,
+    TERMINAL_ATTR_REVERSE   = 1 << 4
+}Terminal_Attribute;
+
+typedef struct
+{
+    uint32_t codepoint;
+    uint16_t fg;
+    uint16_t bg;
+    uint8_t attr;
+}Terminal_Cell;
+
+//Callers draw into cells, terminal_frame_present sends only what changed since the previous
+//frame as one escape-sequence stream in a single write
+typedef struct
+{
+    Terminal_Cell* cells;
+    Terminal_Cell* previous;
+    size_t width;
+    size_t height;
+    bool full_redraw;
+    String_Builder output;
+}Terminal_Frame;
+
+int terminal_size(size_t* width, size_t* height);
+//Flushes stdio first, then writes all of data (escape sequences included) to the terminal
+int terminal_write(const char* data, size_t size);
+
+int terminal_frame_init(Terminal_Frame* frame, size_t width, size_t height);
+int terminal_frame_resize(Terminal_Frame* frame, size_t width, size_t height);
+void terminal_frame_free(Terminal_Frame* frame);
+void terminal_frame_invalidate(Terminal_Frame* frame);
+
+void terminal_frame_clear(Terminal_Frame* frame);
+void terminal_frame_put(Terminal_Frame* frame, size_t x, size_t y, uint32_t codepoint, uint16_t fg, uint16_t bg, uint8_t attr);
+void terminal_frame_fill(Terminal_Frame* frame, size_t x, size_t y, size_t width, size_t height, uint32_t codepoint, uint16_t fg, uint16_t bg, uint8_t attr);
+//Decodes UTF-8 one codepoint per cell (double-width characters are not handled) and clips at
+//the right edge, returns the number of cells written
+size_t terminal_frame_text(Terminal_Frame* frame, size_t x, size_t y, String_View text, uint16_t fg, uint16_t bg, uint8_t attr);
+int terminal_frame_present(Terminal_Frame* frame);
@@ -0,0 +1,304 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#ifdef __linux__
+    //clock_gettime and CLOCK_MONOTONIC under -std=c11
+    #define _GNU_SOURCE
+#endif
+
+#include "LibTerminalProgress.h"
+
+#ifdef __linux__
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+#define TERMINAL_PROGRESS_RATE_SMOOTHING 0.3
+
+static uint64_t __internal_progress_now(void){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+int terminal_progress_init(Terminal_Progress* progress, unsigned interval_ms){
+    if(progress == NULL) return 1;
+
+    memset(progress, 0, sizeof(*progress));
+
+    progress->tty = isatty(STDOUT_FILENO) == 1;
+    if(interval_ms == 0) interval_ms = TERMINAL_PROGRESS_DEFAULT_INTERVAL_MS;
+    if(progress->tty == false && interval_ms < TERMINAL_PROGRESS_PLAIN_INTERVAL_MS) interval_ms = TERMINAL_PROGRESS_PLAIN_INTERVAL_MS;
+
+    progress->interval_ns = (uint64_t)interval_ms * 1000000ULL;
+    progress->start_ns = __internal_progress_now();
+    progress->last_render_ns = progress->start_ns;
+    atomic_init(&progress->next_render_ns, progress->start_ns + progress->interval_ns);
+    atomic_flag_clear(&progress->rendering);
+    sb_init(&progress->output);
+
+    return 0;
+}
+
+static int __internal_progress_add(Terminal_Progress* progress, const char* label, Terminal_Progress_Type type, Terminal_Progress_Unit unit, uint64_t total){
+    if(progress == NULL || label == NULL) return -1;
+
+    if(progress->count >= TERMINAL_PROGRESS_MAX_ITEMS){
+        fprintf(stderr, "[ERROR] Progress display is limited to %d items\n", TERMINAL_PROGRESS_MAX_ITEMS);
+        return -1;
+    }
+
+    Terminal_Progress_Item* item = &progress->items[progress->count];
+    item->type = type;
+    item->unit = unit;
+    snprintf(item->label, sizeof(item->label), "%s", label);
+    atomic_init(&item->value, 0);
+    atomic_init(&item->total, total);
+    item->last_value = 0;
+    item->rate = 0;
+
+    return (int)progress->count++;
+}
+
+int terminal_progress_add_bar(Terminal_Progress* progress, const char* label, uint64_t total, Terminal_Progress_Unit unit){
+    return __internal_progress_add(progress, label, TERMINAL_PROGRESS_BAR, unit, total);
+}
+
+int terminal_progress_add_counter(Terminal_Progress* progress, const char* label, Terminal_Progress_Unit unit){
+    return __internal_progress_add(progress, label, TERMINAL_PROGRESS_COUNTER, unit, 0);
+}
+
+int terminal_progress_add_compression(Terminal_Progress* progress, const char* label){
+    return __internal_progress_add(progress, label, TERMINAL_PROGRESS_COMPRESSION, TERMINAL_PROGRESS_UNIT_BYTES, 0);
+}
+
+static inline Terminal_Progress_Item* __internal_progress_item(Terminal_Progress* progress, int item){
+    if(progress == NULL || item < 0 || (size_t)item >= progress->count) return NULL;
+    return &progress->items[item];
+}
+
+void terminal_progress_advance(Terminal_Progress* progress, int item, uint64_t delta){
+    Terminal_Progress_Item* entry = __internal_progress_item(progress, item);
+    if(entry == NULL) return;
+
+    atomic_fetch_add_explicit(&entry->value, delta, memory_order_relaxed);
+    terminal_progress_tick(progress);
+}
+
+void terminal_progress_set(Terminal_Progress* progress, int item, uint64_t value){
+    Terminal_Progress_Item* entry = __internal_progress_item(progress, item);
+    if(entry == NULL) return;
+
+    atomic_store_explicit(&entry->value, value, memory_order_relaxed);
+    terminal_progress_tick(progress);
+}
+
+void terminal_progress_set_total(Terminal_Progress* progress, int item, uint64_t total){
+    Terminal_Progress_Item* entry = __internal_progress_item(progress, item);
+    if(entry == NULL) return;
+
+    atomic_store_explicit(&entry->total, total, memory_order_relaxed);
+    terminal_progress_tick(progress);
+}
+
+void terminal_progress_add_compressed(Terminal_Progress* progress, int item, uint64_t uncompressed_size, uint64_t compressed_size){
+    Terminal_Progress_Item* entry = __internal_progress_item(progress, item);
+    if(entry == NULL) return;
+
+    atomic_fetch_add_explicit(&entry->value, uncompressed_size, memory_order_relaxed);
+    atomic_fetch_add_explicit(&entry->total, compressed_size, memory_order_relaxed);
+    terminal_progress_tick(progress);
+}
+
+static void __internal_progress_append_amount(String_Builder* output, uint64_t amount, Terminal_Progress_Unit unit){
+    if(unit == TERMINAL_PROGRESS_UNIT_COUNT){
+        sb_appendf(output, "%llu", (unsigned long long)amount);
+        return;
+    }
+
+    static const char* suffixes[] = {"B", "KiB", "MiB", "GiB", "TiB", "PiB"};
+    double scaled = (double)amount;
+    size_t suffix = 0;
+
+    while(scaled >= 1024.0 && suffix + 1 < sizeof(suffixes) / sizeof(suffixes[0])){
+        scaled /= 1024.0;
+        suffix++;
+    }
+
+    if(suffix == 0) sb_appendf(output, "%llu B", (unsigned long long)amount);
+    else sb_appendf(output, "%.1f %s", scaled, suffixes[suffix]);
+}
+
+static void __internal_progress_append_rate(String_Builder* output, double rate, Terminal_Progress_Unit unit){
+    if(unit == TERMINAL_PROGRESS_UNIT_BYTES){
+        __internal_progress_append_amount(output, (uint64_t)rate, unit);
+        sb_append_cstr(output, "/s");
+    }
+    else{
+        sb_appendf(output, "%.1f/s", rate);
+    }
+}
+
+static void __internal_progress_append_duration(String_Builder* output, double seconds){
+    uint64_t total = (uint64_t)seconds;
+    sb_appendf(output, "%02llu:%02llu:%02llu", (unsigned long long)(total / 3600), (unsigned long long)(total / 60 % 60), (unsigned long long)(total % 60));
+}
+
+static void __internal_progress_append_item(Terminal_Progress* progress, Terminal_Progress_Item* item, size_t bar_width){
+    String_Builder* output = &progress->output;
+
+    uint64_t value = atomic_load_explicit(&item->value, memory_order_relaxed);
+    uint64_t total = atomic_load_explicit(&item->total, memory_order_relaxed);
+
+    sb_appendf(output, "%-20s ", item->label);
+
+    switch(item->type){
+        case TERMINAL_PROGRESS_BAR: {
+            double fraction = total > 0 ? (double)(value > total ? total : value) / (double)total : 0.0;
+            size_t filled = (size_t)(fraction * (double)bar_width);
+
+            sb_append_char(output, '[');
+            for(size_t i = 0; i < bar_width; i++){
+                sb_append_char(output, i < filled ? '#' : '.');
+            }
+            sb_appendf(output, "] %5.1f%% ", compute_percentage_from_value((float)fraction));
+
+            __internal_progress_append_amount(output, value, item->unit);
+            sb_append_char(output, '/');
+            __internal_progress_append_amount(output, total, item->unit);
+            sb_append_cstr(output, "  ");
+            __internal_progress_append_rate(output, item->rate, item->unit);
+
+            if(value < total && item->rate > 0){
+                sb_append_cstr(output, "  ETA ");
+                __internal_progress_append_duration(output, (double)(total - value) / item->rate);
+            }
+            break;
+        }
+        case TERMINAL_PROGRESS_COUNTER:
+            __internal_progress_append_amount(output, value, item->unit);
+            sb_append_cstr(output, "  ");
+            __internal_progress_append_rate(output, item->rate, item->unit);
+            break;
+
+        case TERMINAL_PROGRESS_COMPRESSION:
+            __internal_progress_append_amount(output, value, item->unit);
+            sb_append_cstr(output, " -> ");
+            __internal_progress_append_amount(output, total, item->unit);
+
+            if(value > 0 && total > 0){
+                sb_appendf(output, "  ratio %.2f  saving %.1f%%",
+                           compute_compression_ratio((float)value, (float)total),
+                           compute_percentage_from_value(compute_space_saving((float)total, (float)value)));
+            }
+            sb_append_cstr(output, "  ");
+            __internal_progress_append_rate(output, item->rate, item->unit);
+            break;
+    }
+}
+
+//Caller holds the render lock
+static int __internal_progress_render(Terminal_Progress* progress, uint64_t now){
+    double elapsed = (double)(now - progress->last_render_ns) / 1e9;
+
+    for(size_t i = 0; i < progress->count; i++){
+        Terminal_Progress_Item* item = &progress->items[i];
+        uint64_t value = atomic_load_explicit(&item->value, memory_order_relaxed);
+
+        if(elapsed > 0){
+            double current = value >= item->last_value ? (double)(value - item->last_value) / elapsed : 0.0;
+            //The first sample seeds the average instead of being blended with zero
+            item->rate = item->rate == 0 ? current : item->rate + TERMINAL_PROGRESS_RATE_SMOOTHING * (current - item->rate);
+        }
+        item->last_value = value;
+    }
+    progress->last_render_ns = now;
+
+    size_t width = 80;
+    size_t height;
+    if(progress->tty) terminal_size(&width, &height);
+
+    size_t bar_width = width >= 100 ? 40 : width >= 60 ? 20 : 10;
+
+    String_Builder* output = &progress->output;
+    sb_reset(output);
+
+    //Go back to the first line drawn last time and overwrite in place
+    if(progress->tty && progress->lines_drawn > 0) sb_appendf(output, "\r\033[%zuA", progress->lines_drawn);
+
+    for(size_t i = 0; i < progress->count; i++){
+        size_t line_start = output->size;
+
+        __internal_progress_append_item(progress, &progress->items[i], bar_width);
+
+        if(progress->tty){
+            //A wrapped line would break the cursor-up count
+            if(output->size - line_start >= width){
+                output->size = line_start + width - 1;
+                sb_data(output)[output->size] = '\0';
+            }
+            sb_append_cstr(output, "\033[K");
+        }
+        sb_append_char(output, '\n');
+    }
+
+    progress->lines_drawn = progress->count;
+
+    return terminal_write(sb_data(output), output->size);
+}
+
+int terminal_progress_tick(Terminal_Progress* progress){
+    if(progress == NULL) return 1;
+
+    uint64_t now = __internal_progress_now();
+    if(now < atomic_load_explicit(&progress->next_render_ns, memory_order_relaxed)) return 0;
+
+    //Whoever loses the race just goes back to work
+    if(atomic_flag_test_and_set_explicit(&progress->rendering, memory_order_acquire)) return 0;
+
+    int result = 0;
+    if(now >= atomic_load_explicit(&progress->next_render_ns, memory_order_relaxed)){
+        result = __internal_progress_render(progress, now);
+        atomic_store_explicit(&progress->next_render_ns, now + progress->interval_ns, memory_order_relaxed);
+    }
+
+    atomic_flag_clear_explicit(&progress->rendering, memory_order_release);
+    return result;
+}
+
+int terminal_progress_finish(Terminal_Progress* progress){
+    if(progress == NULL) return 1;
+
+    while(atomic_flag_test_and_set_explicit(&progress->rendering, memory_order_acquire)){
+        sched_yield();
+    }
+
+    int result = __internal_progress_render(progress, __internal_progress_now());
+    sb_free(&progress->output);
+    progress->lines_drawn = 0;
+
+    atomic_flag_clear_explicit(&progress->rendering, memory_order_release);
+    return result;
+}
+#endif
@@ -0,0 +1,93 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+
+#include "LibTerminalFrame.h"
+#include "../LibMath/LibMath.h"
+
+#ifdef __linux__
+#include <stdatomic.h>
+
+#define TERMINAL_PROGRESS_MAX_ITEMS 16
+#define TERMINAL_PROGRESS_LABEL_SIZE 32
+#define TERMINAL_PROGRESS_DEFAULT_INTERVAL_MS 100
+//Without a tty every redraw becomes new lines in a log, so they are spaced further apart
+#define TERMINAL_PROGRESS_PLAIN_INTERVAL_MS 5000
+
+typedef enum{
+    TERMINAL_PROGRESS_BAR,
+    TERMINAL_PROGRESS_COUNTER,
+    TERMINAL_PROGRESS_COMPRESSION
+}Terminal_Progress_Type;
+
+typedef enum{
+    TERMINAL_PROGRESS_UNIT_COUNT,
+    TERMINAL_PROGRESS_UNIT_BYTES
+}Terminal_Progress_Unit;
+
+typedef struct
+{
+    Terminal_Progress_Type type;
+    Terminal_Progress_Unit unit;
+    char label[TERMINAL_PROGRESS_LABEL_SIZE];
+    //value is the uncompressed size and total the compressed size for TERMINAL_PROGRESS_COMPRESSION
+    _Atomic uint64_t value;
+    _Atomic uint64_t total;
+    //Only touched by the thread holding the render lock
+    uint64_t last_value;
+    double rate;
+}Terminal_Progress_Item;
+
+typedef struct
+{
+    Terminal_Progress_Item items[TERMINAL_PROGRESS_MAX_ITEMS];
+    size_t count;
+    bool tty;
+    uint64_t interval_ns;
+    uint64_t start_ns;
+    uint64_t last_render_ns;
+    size_t lines_drawn;
+    _Atomic uint64_t next_render_ns;
+    atomic_flag rendering;
+    String_Builder output;
+}Terminal_Progress;
+
+//interval_ms of 0 selects TERMINAL_PROGRESS_DEFAULT_INTERVAL_MS
+int terminal_progress_init(Terminal_Progress* progress, unsigned interval_ms);
+//Items have to be added before worker threads start updating them, they return the item index or -1
+int terminal_progress_add_bar(Terminal_Progress* progress, const char* label, uint64_t total, Terminal_Progress_Unit unit);
+int terminal_progress_add_counter(Terminal_Progress* progress, const char* label, Terminal_Progress_Unit unit);
+int terminal_progress_add_compression(Terminal_Progress* progress, const char* label);
+
+//Safe from any thread, they redraw only when the interval elapsed and nobody else is drawing
+void terminal_progress_advance(Terminal_Progress* progress, int item, uint64_t delta);
+void terminal_progress_set(Terminal_Progress* progress, int item, uint64_t value);
+void terminal_progress_set_total(Terminal_Progress* progress, int item, uint64_t total);
+void terminal_progress_add_compressed(Terminal_Progress* progress, int item, uint64_t uncompressed_size, uint64_t compressed_size);
+int terminal_progress_tick(Terminal_Progress* progress);
+
+//Draws the final state and releases the output buffer
+int terminal_progress_finish(Terminal_Progress* progress);
+#endif
@@ -0,0 +1,116 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+//Helpers shared by the standalone benchmark programs in this directory.
+//Every benchmark is its own program, the build line is at the top of each file.
+
+#pragma once
+
+#ifdef __linux__
+    //clock_gettime under -std=c11, bench.h has to be the first include
+    #ifndef _GNU_SOURCE
+        #define _GNU_SOURCE
+    #endif
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+static inline uint64_t bench_now_ns(void){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+//Stops the compiler from discarding a result that is otherwise never used
+static inline void bench_keep(uint64_t value){
+    static volatile uint64_t sink;
+    sink ^= value;
+}
+
+//Makes the compiler assume memory changed, so pure calls in a timing loop are not hoisted out of it
+#if defined(__GNUC__) || defined(__clang__)
+    #define bench_clobber() __asm__ __volatile__("" ::: "memory")
+#else
+    #define bench_clobber() ((void)0)
+#endif
+
+static inline void bench_report_bytes(const char* name, size_t bytes, uint64_t ns){
+    double seconds = (double)ns / 1e9;
+    printf("%-40s %10.1f MB/s %10.3f ms\n", name, (double)bytes / (1024.0 * 1024.0) / seconds, seconds * 1e3);
+}
+
+static inline void bench_report_items(const char* name, size_t items, const char* unit, uint64_t ns){
+    double seconds = (double)ns / 1e9;
+    printf("%-40s %12.0f %s/s %10.1f ns each\n", name, (double)items / seconds, unit, (double)ns / (double)items);
+}
+
+//Deterministic printable text with newlines every 40-120 bytes, roughly like a log file
+static inline void bench_fill_text(char* buffer, size_t size, uint64_t seed){
+    static const char alphabet[] = "abcdefghijklmnopqrstuvwxyz    ABCDEFGHIJ0123456789.,:=-_/[]";
+    uint64_t state = seed * 0x9E3779B97F4A7C15ULL + 1;
+    size_t next_newline = 40;
+
+    for(size_t i = 0; i < size; i++){
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        if(i == next_newline){
+            buffer[i] = '\n';
+            next_newline += 40 + (size_t)(state % 81);
+            continue;
+        }
+        buffer[i] = alphabet[state % (sizeof(alphabet) - 1)];
+    }
+}
+
+//Writes size bytes of bench_fill_text to file, returns false when it could not
+static inline bool bench_make_file(const char* file, size_t size){
+    char* buffer = (char*)malloc(size > 0 ? size : 1);
+    if(buffer == NULL) return false;
+
+    bench_fill_text(buffer, size, 42);
+
+    FILE* output = fopen(file, "wb");
+    bool written = output != NULL && fwrite(buffer, 1, size, output) == size;
+    if(output != NULL && fclose(output) != 0) written = false;
+
+    free(buffer);
+    return written;
+}
+
+//Times rounds evaluations of expression and reports them as bytes_per_round bytes each
+#define BENCH_RUN(name, bytes_per_round, rounds, expression) do { \
+        uint64_t bench_start = bench_now_ns(); \
+        for(size_t bench_round = 0; bench_round < (size_t)(rounds); bench_round++){ \
+            bench_clobber(); \
+            bench_keep((uint64_t)(expression)); \
+        } \
+        bench_report_bytes(name, (size_t)(bytes_per_round) * (size_t)(rounds), bench_now_ns() - bench_start); \
+    } while(0)
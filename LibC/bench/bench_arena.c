@@ -0,0 +1,166 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+//Allocation-heavy request parsing, every field copied out as a C string: calloc/free against an
+//arena scope per request.
+//Build: cc -O2 -std=gnu11 bench_arena.c ../LibString/LibStringView.c ../LibArena/LibArena.c -o bench_arena
+//Usage: bench_arena [requests]
+
+#include "bench.h"
+#include "../LibArena/LibArena.h"
+#include "../LibString/LibStringView.h"
+
+#define BENCH_FIELDS_PER_REQUEST 12
+
+typedef struct
+{
+    char* key;
+    char* value;
+}Field;
+
+typedef struct
+{
+    Field* fields;
+    size_t count;
+}Request;
+
+static char* make_requests(size_t count, size_t* size){
+    size_t capacity = count * BENCH_FIELDS_PER_REQUEST * 32 + 1;
+    char* text = (char*)malloc(capacity);
+    if(text == NULL) return NULL;
+
+    size_t used = 0;
+    for(size_t i = 0; i < count; i++){
+        for(size_t field = 0; field < BENCH_FIELDS_PER_REQUEST; field++){
+            used += (size_t)snprintf(text + used, capacity - used, "%sfield%zu=value-%zu-%zu",
+                                     field == 0 ? "" : ",", field, i, field * 7919 % 1000);
+        }
+        text[used++] = '\n';
+    }
+
+    *size = used;
+    return text;
+}
+
+static size_t parse_malloc(String_View text){
+    size_t total = 0;
+    Sv_Split lines = sv_split(text);
+    String_View line;
+
+    while(sv_split_next_line(&lines, &line)){
+        Request* request = (Request*)calloc(1, sizeof(Request));
+        if(request == NULL) return total;
+        request->fields = (Field*)calloc(BENCH_FIELDS_PER_REQUEST, sizeof(Field));
+        if(request->fields == NULL){
+            free(request);
+            return total;
+        }
+
+        Sv_Split pairs = sv_split(line);
+        String_View pair;
+        while(sv_split_next(&pairs, ',', &pair) && request->count < BENCH_FIELDS_PER_REQUEST){
+            String_View key = sv_chop_by_delim(&pair, '=');
+            request->fields[request->count].key = sv_to_cstr(key);
+            request->fields[request->count].value = sv_to_cstr(pair);
+            request->count++;
+        }
+
+        total += request->count;
+        for(size_t i = 0; i < request->count; i++){
+            free(request->fields[i].key);
+            free(request->fields[i].value);
+        }
+        free(request->fields);
+        free(request);
+    }
+
+    return total;
+}
+
+static size_t parse_arena(Arena* arena, String_View text){
+    size_t total = 0;
+    Sv_Split lines = sv_split(text);
+    String_View line;
+
+    while(sv_split_next_line(&lines, &line)){
+        Arena_Scope scope = arena_scope_begin(arena);
+
+        Request* request = (Request*)arena_alloc_zero(arena, sizeof(Request));
+        if(request == NULL) return total;
+        request->fields = (Field*)arena_alloc_zero(arena, BENCH_FIELDS_PER_REQUEST * sizeof(Field));
+        if(request->fields == NULL){
+            arena_scope_end(&scope);
+            return total;
+        }
+
+        Sv_Split pairs = sv_split(line);
+        String_View pair;
+        while(sv_split_next(&pairs, ',', &pair) && request->count < BENCH_FIELDS_PER_REQUEST){
+            String_View key = sv_chop_by_delim(&pair, '=');
+            request->fields[request->count].key = sv_to_cstr_arena(arena, key);
+            request->fields[request->count].value = sv_to_cstr_arena(arena, pair);
+            request->count++;
+        }
+
+        total += request->count;
+        arena_scope_end(&scope);
+    }
+
+    return total;
+}
+
+int main(int argc, char** argv){
+    size_t count = argc > 1 ? strtoul(argv[1], NULL, 10) : 200000;
+
+    size_t size = 0;
+    char* text = make_requests(count, &size);
+    if(text == NULL) return 1;
+    String_View sv = sv_from_parts(text, size);
+
+    //Each request makes 2 + 2 * fields allocations
+    size_t allocations = count * (2 + 2 * BENCH_FIELDS_PER_REQUEST);
+    printf("%zu requests, %d fields each, %zu allocations per pass\n", count, BENCH_FIELDS_PER_REQUEST, allocations);
+
+    //Warm both paths once so neither pays for first touching its memory
+    bench_keep(parse_malloc(sv));
+    Arena arena;
+    arena_init(&arena, ARENA_DEFAULT_BLOCK_SIZE);
+    bench_keep(parse_arena(&arena, sv));
+
+    uint64_t start = bench_now_ns();
+    bench_keep(parse_malloc(sv));
+    uint64_t elapsed = bench_now_ns() - start;
+    bench_report_items("calloc + free per field", allocations, "allocs", elapsed);
+    bench_report_bytes("calloc + free per field", size, elapsed);
+
+    start = bench_now_ns();
+    bench_keep(parse_arena(&arena, sv));
+    elapsed = bench_now_ns() - start;
+    bench_report_items("arena scope per request", allocations, "allocs", elapsed);
+    bench_report_bytes("arena scope per request", size, elapsed);
+
+    arena_free(&arena);
+    free(text);
+    return 0;
+}
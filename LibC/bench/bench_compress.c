@@ -0,0 +1,158 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+//Compression and decompression throughput: raw blocks, and whole frames with and without the checksum.
+//Build: cc -O2 -std=gnu11 bench_compress.c ../LibCompress/LibCompress.c ../LibHash/LibHash.c ../LibMath/LibMath.c ../LibString/LibStringBuilder.c ../LibString/LibStringView.c ../LibFile/LibFile.c ../LibArena/LibArena.c -lm -o bench_compress
+//Usage: bench_compress [size in MB | file] [rounds]
+
+#include "bench.h"
+#include "../LibCompress/LibCompress.h"
+#include "../LibFile/LibFile.h"
+
+#include <ctype.h>
+
+static uint64_t bench_random(uint64_t* state){
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+//Log lines with repeating structure and random fields, compressible about like real logs
+static void make_log_text(char* buffer, size_t size){
+    static const char* levels[] = {"INFO ", "INFO ", "INFO ", "DEBUG", "WARN ", "ERROR"};
+    static const char* paths[] = {"/api/v1/items", "/api/v1/users", "/static/app.js", "/health", "/api/v2/orders/search"};
+    uint64_t state = 88172645463325252ULL;
+    size_t used = 0;
+    char line[256];
+
+    while(used < size){
+        uint64_t a = bench_random(&state);
+        uint64_t b = bench_random(&state);
+        int length = snprintf(line, sizeof(line), "2026-10-18 %02u:%02u:%02u.%03u [%s] worker %2u handled %s/%u status=%u bytes=%u in %u.%03ums\n",
+            (unsigned)(a % 24), (unsigned)(a >> 8 & 63) % 60, (unsigned)(a >> 16 & 63) % 60, (unsigned)(a >> 24 % 1000) % 1000,
+            levels[b % 6], (unsigned)(b >> 8 & 15), paths[(b >> 12) % 5], (unsigned)(b >> 16 & 0xFFFF),
+            (b >> 32 & 15) == 0 ? 404u : 200u, (unsigned)(b >> 36 & 0xFFFF), (unsigned)(b >> 52 & 31), (unsigned)(a >> 40) % 1000);
+
+        size_t copy = (size_t)length < size - used ? (size_t)length : size - used;
+        memcpy(buffer + used, line, copy);
+        used += copy;
+    }
+}
+
+static bool decompress_blocks(const uint8_t* blocks, const size_t* sizes, size_t count, uint8_t* output, size_t block_size){
+    for(size_t i = 0; i < count; i++){
+        size_t produced;
+        if(decompress_block(blocks, sizes[i], output, block_size, &produced) == false) return false;
+        blocks += sizes[i];
+        output += produced;
+    }
+    return true;
+}
+
+int main(int argc, char** argv){
+    int rounds = argc > 2 ? atoi(argv[2]) : 10;
+    char* data = NULL;
+    size_t size = 0;
+
+    if(argc > 1 && isdigit((unsigned char)argv[1][0]) == false){
+        data = read_entire_file(argv[1]);
+        if(data == NULL) return 1;
+        size = strlen(data);
+        printf("%s, %.1f MB, %d rounds\n", argv[1], (double)size / (1024.0 * 1024.0), rounds);
+    }
+    else{
+        size = (argc > 1 ? strtoul(argv[1], NULL, 10) : 64) * 1024 * 1024;
+        data = (char*)malloc(size);
+        if(data == NULL) return 1;
+        make_log_text(data, size);
+        printf("generated log text, %.1f MB, %d rounds\n", (double)size / (1024.0 * 1024.0), rounds);
+    }
+
+    //Raw blocks first, without any frame work around the codec
+    size_t block_size = COMPRESS_DEFAULT_BLOCK_SIZE;
+    size_t count = (size + block_size - 1) / block_size;
+    uint8_t* blocks = (uint8_t*)malloc(count * compress_block_bound(block_size));
+    size_t* sizes = (size_t*)malloc(count * sizeof(size_t));
+    uint8_t* output = (uint8_t*)malloc(size);
+    if(blocks == NULL || sizes == NULL || output == NULL) return 1;
+
+    uint64_t start = bench_now_ns();
+    size_t compressed = 0;
+    for(int round = 0; round < rounds; round++){
+        compressed = 0;
+        for(size_t i = 0; i < count; i++){
+            size_t chunk = i + 1 < count ? block_size : size - i * block_size;
+            sizes[i] = compress_block(data + i * block_size, chunk, blocks + compressed, compress_block_bound(chunk));
+            if(sizes[i] == 0) return 1;
+            compressed += sizes[i];
+        }
+    }
+    bench_report_bytes("compress_block", size * (size_t)rounds, bench_now_ns() - start);
+    printf("%-40s %10.2f\n", "ratio", (double)size / (double)compressed);
+
+    //One untimed round so page faults on the output do not count as decoding
+    if(decompress_blocks(blocks, sizes, count, output, block_size) == false) return 1;
+
+    start = bench_now_ns();
+    for(int round = 0; round < rounds; round++){
+        if(decompress_blocks(blocks, sizes, count, output, block_size) == false) return 1;
+        bench_clobber();
+    }
+    bench_report_bytes("decompress_block", size * (size_t)rounds, bench_now_ns() - start);
+
+    if(memcmp(output, data, size) != 0){
+        fprintf(stderr, "[ERROR] decompress_block does not roundtrip\n");
+        return 1;
+    }
+
+    free(blocks);
+    free(sizes);
+    free(output);
+
+    //Whole frames, the way callers use the library. Every call returns a fresh allocation, so for
+    //large inputs the page faults on it are part of what is measured.
+    for(int checksum = 1; checksum >= 0; checksum--){
+        Compress_Options options = {.block_size = block_size, .checksum = checksum};
+        void* frame = NULL;
+        size_t frame_size = 0;
+
+        if(compress_buffer(data, size, &frame, &frame_size, &options, NULL) == false) return 1;
+
+        start = bench_now_ns();
+        for(int round = 0; round < rounds; round++){
+            void* decompressed = NULL;
+            size_t decompressed_size = 0;
+            if(decompress_buffer(frame, frame_size, &decompressed, &decompressed_size, NULL) == false) return 1;
+            bench_keep(decompressed_size);
+            free(decompressed);
+        }
+        bench_report_bytes(checksum ? "decompress_buffer (checksum)" : "decompress_buffer", size * (size_t)rounds, bench_now_ns() - start);
+
+        free(frame);
+    }
+
+    free(data);
+    return 0;
+}
@@ -0,0 +1,124 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+//Whole-file reads through the async API at several queue depths against the stdio read_entire_file.
+//Build: cc -O2 -std=gnu11 bench_file_async.c ../LibFile/LibFileAsync.c ../LibFile/LibFile.c ../LibString/LibStringView.c ../LibArena/LibArena.c -lpthread -o bench_file_async
+//Usage: bench_file_async [file count] [file size in KB]
+
+#include "bench.h"
+#include "../LibFile/LibFile.h"
+#include "../LibFile/LibFileAsync.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define BENCH_ROOT "bench_file_async.tmp"
+
+static void bench_path(char* path, size_t size, size_t index){
+    snprintf(path, size, BENCH_ROOT "/%zu.txt", index);
+}
+
+static bool bench_read_async(Async_File_Backend backend, unsigned queue_depth, size_t count, size_t* bytes){
+    Async_File_IO io;
+    if(async_file_io_init(&io, queue_depth, backend) == false) return false;
+
+    for(size_t i = 0; i < count; i++){
+        char path[256];
+        bench_path(path, sizeof(path), i);
+        if(async_read_entire_file(&io, path, NULL) == false) break;
+    }
+    async_file_io_submit(&io);
+
+    bool success = true;
+    Async_File_Result result;
+    while(async_file_io_wait(&io, &result)){
+        if(result.success == false) success = false;
+        *bytes += result.size;
+        free(result.data);
+    }
+
+    async_file_io_destroy(&io);
+    return success;
+}
+
+int main(int argc, char** argv){
+    size_t count = argc > 1 ? strtoul(argv[1], NULL, 10) : 1024;
+    size_t size = (argc > 2 ? strtoul(argv[2], NULL, 10) : 256) * 1024;
+
+    if(mkdir(BENCH_ROOT, 0755) != 0){
+        fprintf(stderr, "[ERROR] Could not create %s\n", BENCH_ROOT);
+        return 1;
+    }
+
+    for(size_t i = 0; i < count; i++){
+        char path[256];
+        bench_path(path, sizeof(path), i);
+        if(bench_make_file(path, size) == false){
+            fprintf(stderr, "[ERROR] Could not create %s\n", path);
+            return 1;
+        }
+    }
+
+    printf("%zu files of %zu KB, page cache warm\n", count, size / 1024);
+
+    size_t bytes = 0;
+    uint64_t start = bench_now_ns();
+    for(size_t i = 0; i < count; i++){
+        char path[256];
+        bench_path(path, sizeof(path), i);
+        char* data = read_entire_file(path);
+        if(data == NULL) return 1;
+        bytes += size;
+        free(data);
+    }
+    bench_report_bytes("read_entire_file (stdio)", bytes, bench_now_ns() - start);
+
+    const Async_File_Backend backends[] = {ASYNC_FILE_BACKEND_URING, ASYNC_FILE_BACKEND_THREADS};
+    const char* backend_names[] = {"io_uring", "threads"};
+    const unsigned depths[] = {1, 4, 16, 64, 256};
+
+    for(size_t b = 0; b < 2; b++){
+        for(size_t d = 0; d < sizeof(depths) / sizeof(depths[0]); d++){
+            char name[64];
+            snprintf(name, sizeof(name), "async %s depth %u", backend_names[b], depths[d]);
+
+            bytes = 0;
+            start = bench_now_ns();
+            if(bench_read_async(backends[b], depths[d], count, &bytes) == false){
+                printf("%-40s unavailable\n", name);
+                break;
+            }
+            bench_report_bytes(name, bytes, bench_now_ns() - start);
+        }
+    }
+
+    for(size_t i = 0; i < count; i++){
+        char path[256];
+        bench_path(path, sizeof(path), i);
+        remove(path);
+    }
+    rmdir(BENCH_ROOT);
+
+    return 0;
+}
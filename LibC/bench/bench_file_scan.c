@@ -0,0 +1,140 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+//Files classified per second: one detect_file_type call per file against the classify_* worker pool.
+//Build: cc -O2 -std=gnu11 bench_file_scan.c ../LibFile/LibFileScan.c ../LibFile/LibFile.c ../LibString/LibStringView.c ../LibArena/LibArena.c -lpthread -o bench_file_scan
+//Usage: bench_file_scan [file count]
+
+#include "bench.h"
+
+#define CHECK_FILE_TYPE_IMPLEMENTATION
+#include "../LibFile/LibFileScan.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <stdatomic.h>
+
+#define BENCH_ROOT "bench_file_scan.tmp"
+#define BENCH_FILES_PER_DIRECTORY 500
+
+static const unsigned char bench_png[] = {0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A};
+static const unsigned char bench_elf[] = {0x7F, 'E', 'L', 'F', 2, 1, 1, 0};
+static const unsigned char bench_pdf[] = {'%', 'P', 'D', 'F', '-', '1', '.', '7'};
+static const unsigned char bench_text[] = {'h', 'e', 'l', 'l', 'o', ' ', 'b', 'e'};
+
+static void bench_path(char* path, size_t size, size_t index){
+    snprintf(path, size, BENCH_ROOT "/%zu/%zu.bin", index / BENCH_FILES_PER_DIRECTORY, index);
+}
+
+static bool bench_make_tree(char** paths, size_t count){
+    const unsigned char* headers[] = {bench_png, bench_elf, bench_pdf, bench_text};
+    char body[1024];
+    bench_fill_text(body, sizeof(body), 7);
+
+    if(mkdir(BENCH_ROOT, 0755) != 0) return false;
+
+    for(size_t i = 0; i < count; i++){
+        char path[256];
+        if(i % BENCH_FILES_PER_DIRECTORY == 0){
+            snprintf(path, sizeof(path), BENCH_ROOT "/%zu", i / BENCH_FILES_PER_DIRECTORY);
+            if(mkdir(path, 0755) != 0) return false;
+        }
+
+        bench_path(path, sizeof(path), i);
+        FILE* file = fopen(path, "wb");
+        if(file == NULL) return false;
+        fwrite(headers[i % 4], 1, 8, file);
+        fwrite(body, 1, sizeof(body), file);
+        fclose(file);
+
+        paths[i] = strdup(path);
+        if(paths[i] == NULL) return false;
+    }
+
+    return true;
+}
+
+static void bench_remove_tree(char** paths, size_t count){
+    for(size_t i = 0; i < count; i++){
+        if(paths[i] == NULL) continue;
+        remove(paths[i]);
+        free(paths[i]);
+    }
+
+    for(size_t i = 0; i < count; i += BENCH_FILES_PER_DIRECTORY){
+        char path[256];
+        snprintf(path, sizeof(path), BENCH_ROOT "/%zu", i / BENCH_FILES_PER_DIRECTORY);
+        rmdir(path);
+    }
+    rmdir(BENCH_ROOT);
+}
+
+static void bench_count(const char* file, File_Type type, void* user_data){
+    (void)file;
+    (void)type;
+    atomic_fetch_add_explicit((atomic_size_t*)user_data, 1, memory_order_relaxed);
+}
+
+int main(int argc, char** argv){
+    size_t count = argc > 1 ? strtoul(argv[1], NULL, 10) : 20000;
+
+    char** paths = (char**)calloc(count, sizeof(char*));
+    File_Type* results = (File_Type*)calloc(count, sizeof(File_Type));
+    if(paths == NULL || results == NULL) return 1;
+
+    if(bench_make_tree(paths, count) == false){
+        fprintf(stderr, "[ERROR] Could not create the tree under %s\n", BENCH_ROOT);
+        bench_remove_tree(paths, count);
+        return 1;
+    }
+
+    printf("%zu files, %ld cores, page cache warm\n", count, sysconf(_SC_NPROCESSORS_ONLN));
+
+    uint64_t start = bench_now_ns();
+    for(size_t i = 0; i < count; i++){
+        results[i] = detect_file_type(paths[i]);
+    }
+    bench_report_items("detect_file_type loop", count, "files", bench_now_ns() - start);
+
+    const size_t thread_counts[] = {1, 2, 4, 8, 16, 0};
+    for(size_t i = 0; i < sizeof(thread_counts) / sizeof(thread_counts[0]); i++){
+        char name[64];
+        if(thread_counts[i] == 0) snprintf(name, sizeof(name), "classify_files default threads");
+        else snprintf(name, sizeof(name), "classify_files %zu threads", thread_counts[i]);
+
+        start = bench_now_ns();
+        classify_files((const char**)paths, count, results, thread_counts[i]);
+        bench_report_items(name, count, "files", bench_now_ns() - start);
+    }
+
+    atomic_size_t visited = 0;
+    start = bench_now_ns();
+    classify_directory(BENCH_ROOT, 0, bench_count, &visited);
+    bench_report_items("classify_directory default threads", atomic_load(&visited), "files", bench_now_ns() - start);
+
+    bench_remove_tree(paths, count);
+    free(paths);
+    free(results);
+    return 0;
+}
@@ -0,0 +1,79 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+//Hash throughput per algorithm on cached buffers of several sizes, plus the hash_file_* paths.
+//Build: cc -O2 -std=gnu11 bench_hash.c ../LibHash/LibHash.c ../LibFile/LibFile.c ../LibString/LibStringView.c ../LibArena/LibArena.c -o bench_hash
+//Usage: bench_hash [file size in MB]
+
+#include "bench.h"
+#include "../LibHash/LibHash.h"
+
+#define BENCH_FILE "bench_hash.tmp"
+
+//Roughly this many bytes hashed per algorithm and size, so short inputs get enough rounds
+#define BENCH_BYTES_PER_CASE ((size_t)1 << 30)
+
+int main(int argc, char** argv){
+    size_t megabytes = argc > 1 ? strtoul(argv[1], NULL, 10) : 256;
+    static const size_t sizes[] = {16, 64, 1024, 64 * 1024, 1024 * 1024};
+    size_t largest = sizes[sizeof(sizes) / sizeof(sizes[0]) - 1];
+
+    char* buffer = (char*)malloc(largest);
+    if(buffer == NULL) return 1;
+    bench_fill_text(buffer, largest, 7);
+
+    for(size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++){
+        size_t size = sizes[i];
+        size_t rounds = BENCH_BYTES_PER_CASE / size;
+
+        printf("\n%zu byte inputs, %zu rounds\n", size, rounds);
+
+        BENCH_RUN("hash_crc32c", size, rounds, hash_crc32c(0, buffer, size));
+
+        BENCH_RUN("hash_xxh64", size, rounds, hash_xxh64(buffer, size, 0));
+
+        BENCH_RUN("hash_murmur3_128", size, rounds, hash_murmur3_128(buffer, size, 0).low);
+    }
+
+    free(buffer);
+
+    size_t file_size = megabytes * 1024 * 1024;
+    if(bench_make_file(BENCH_FILE, file_size) == false){
+        fprintf(stderr, "[ERROR] Could not create %s\n", BENCH_FILE);
+        return 1;
+    }
+
+    printf("\n%zu MB file, page cache warm\n", megabytes);
+
+    uint32_t crc = 0;
+    uint64_t xxh = 0;
+    Hash_128 murmur = {0};
+    BENCH_RUN("hash_file_crc32c", file_size, 3, hash_file_crc32c(BENCH_FILE, &crc));
+    BENCH_RUN("hash_file_xxh64", file_size, 3, hash_file_xxh64(BENCH_FILE, 0, &xxh));
+    BENCH_RUN("hash_file_murmur3_128", file_size, 3, hash_file_murmur3_128(BENCH_FILE, 0, &murmur));
+    bench_keep(crc ^ xxh ^ murmur.low);
+
+    remove(BENCH_FILE);
+    return 0;
+}
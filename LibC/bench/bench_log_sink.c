@@ -0,0 +1,99 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+//Lines per second written through log_file (open, write, close per call) against a LogSink.
+//Build: cc -O2 -std=gnu11 bench_log_sink.c -lpthread -o bench_log_sink
+//Usage: bench_log_sink [lines]
+
+#include "bench.h"
+
+#define LIB_LOG_IMPLEMENTATION
+#include "../logging/log.h"
+
+#define BENCH_LOG "bench_log_sink.tmp"
+
+static size_t bench_count_lines(const char* file){
+    FILE* input = fopen(file, "rb");
+    if(input == NULL) return 0;
+
+    size_t lines = 0;
+    char buffer[64 * 1024];
+    size_t got;
+    while((got = fread(buffer, 1, sizeof(buffer), input)) > 0){
+        for(size_t i = 0; i < got; i++) lines += buffer[i] == '\n';
+    }
+
+    fclose(input);
+    return lines;
+}
+
+static void bench_sink(const char* name, LogSinkConfig config, size_t lines, size_t error_every){
+    remove(BENCH_LOG);
+
+    LogSink sink;
+    if(log_sink_open(&sink, BENCH_LOG, config) == false) return;
+
+    uint64_t start = bench_now_ns();
+    for(size_t i = 0; i < lines; i++){
+        LogType type = (error_every > 0 && i % error_every == 0) ? Error : Info;
+        log_sink_write(&sink, type, "request %zu served in %d us from %s\n", i, (int)(i % 977), "worker-3");
+    }
+    log_sink_close(&sink);
+    uint64_t elapsed = bench_now_ns() - start;
+
+    bench_report_items(name, lines, "lines", elapsed);
+    if(config.rotate_size == 0 && bench_count_lines(BENCH_LOG) != lines){
+        printf("%-40s lost lines: %zu of %zu written\n", name, bench_count_lines(BENCH_LOG), lines);
+    }
+}
+
+int main(int argc, char** argv){
+    size_t lines = argc > 1 ? strtoul(argv[1], NULL, 10) : 200000;
+
+    printf("%zu lines\n", lines);
+
+    remove(BENCH_LOG);
+    uint64_t start = bench_now_ns();
+    for(size_t i = 0; i < lines; i++){
+        log_file(Info, BENCH_LOG, "request %zu served in %d us from %s\n", i, (int)(i % 977), "worker-3");
+    }
+    bench_report_items("log_file", lines, "lines", bench_now_ns() - start);
+
+    LogSinkConfig config = {0};
+    bench_sink("log_sink default buffer", config, lines, 0);
+
+    config.buffer_size = 4096;
+    bench_sink("log_sink 4 KB buffer", config, lines, 0);
+
+    config.buffer_size = 0;
+    config.flush_on = LOG_SINK_FLUSH_ON(Error);
+    bench_sink("log_sink flush on every 100th (error)", config, lines, 100);
+
+    config.flush_on = 0;
+    config.flush_interval_ms = 1;
+    bench_sink("log_sink 1 ms flush interval", config, lines, 0);
+
+    remove(BENCH_LOG);
+    return 0;
+}
@@ -0,0 +1,86 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+//Mapped files against the calloc+fread copy of read_entire_file, both walking every byte once.
+//Build: cc -O2 -std=gnu11 bench_mapped_file.c ../LibFile/LibFile.c ../LibString/LibStringView.c ../LibArena/LibArena.c -o bench_mapped_file
+//Usage: bench_mapped_file [size in MB] [rounds]
+
+#include "bench.h"
+#include "../LibFile/LibFile.h"
+
+#define BENCH_FILE "bench_mapped_file.tmp"
+
+static size_t count_lines(const char* data, size_t size){
+    size_t lines = 0;
+    const char* end = data + size;
+
+    while(data < end){
+        const char* newline = (const char*)memchr(data, '\n', (size_t)(end - data));
+        if(newline == NULL) break;
+        lines++;
+        data = newline + 1;
+    }
+
+    return lines;
+}
+
+int main(int argc, char** argv){
+    size_t megabytes = argc > 1 ? strtoul(argv[1], NULL, 10) : 256;
+    int rounds = argc > 2 ? atoi(argv[2]) : 5;
+    size_t size = megabytes * 1024 * 1024;
+
+    if(bench_make_file(BENCH_FILE, size) == false){
+        fprintf(stderr, "[ERROR] Could not create %s\n", BENCH_FILE);
+        return 1;
+    }
+
+    printf("%zu MB file, %d rounds, page cache warm\n", megabytes, rounds);
+
+    uint64_t read_ns = 0;
+    uint64_t map_ns = 0;
+
+    for(int round = 0; round < rounds; round++){
+        uint64_t start = bench_now_ns();
+        char* data = read_entire_file(BENCH_FILE);
+        if(data == NULL) return 1;
+        bench_keep(count_lines(data, size));
+        free(data);
+        read_ns += bench_now_ns() - start;
+
+        start = bench_now_ns();
+        Mapped_File mapped_file;
+        if(map_file(&mapped_file, BENCH_FILE, false) == false) return 1;
+        advise_mapped_file(&mapped_file, FILE_ADVICE_SEQUENTIAL);
+        String_View view = mapped_file_to_sv(mapped_file);
+        bench_keep(count_lines(view.string, view.size));
+        unmap_file(&mapped_file);
+        map_ns += bench_now_ns() - start;
+    }
+
+    bench_report_bytes("read_entire_file (calloc+fread)", size * (size_t)rounds, read_ns);
+    bench_report_bytes("map_file", size * (size_t)rounds, map_ns);
+
+    remove(BENCH_FILE);
+    return 0;
+}
@@ -0,0 +1,157 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+//Building large output and many short strings: String_Builder against the ways it is done without one.
+//Build: cc -O2 -std=gnu11 bench_string_builder.c ../LibString/LibStringBuilder.c ../LibString/LibStringView.c ../LibArena/LibArena.c -o bench_string_builder
+//Usage: bench_string_builder [lines]
+
+#include "bench.h"
+#include "../LibString/LibStringBuilder.h"
+
+static const char* names[] = {"alpha", "bravo", "charlie", "delta", "echo", "foxtrot", "golf", "hotel"};
+
+//strcat onto one buffer: every append walks everything written so far
+static size_t report_strcat(size_t lines){
+    char* output = (char*)calloc(lines * 64 + 1, 1);
+    if(output == NULL) return 0;
+
+    char line[128];
+    for(size_t i = 0; i < lines; i++){
+        snprintf(line, sizeof(line), "row %zu: name=%s value=%d\n", i, names[i % 8], (int)(i * 7 % 1000));
+        strcat(output, line);
+    }
+
+    size_t size = strlen(output);
+    free(output);
+    return size;
+}
+
+//Exact-size realloc per line through a temporary buffer, the usual hand-rolled approach
+static size_t report_realloc(size_t lines){
+    char* output = NULL;
+    size_t size = 0;
+
+    char line[128];
+    for(size_t i = 0; i < lines; i++){
+        int length = snprintf(line, sizeof(line), "row %zu: name=%s value=%d\n", i, names[i % 8], (int)(i * 7 % 1000));
+        char* grown = (char*)realloc(output, size + (size_t)length + 1);
+        if(grown == NULL){
+            free(output);
+            return 0;
+        }
+        output = grown;
+        memcpy(output + size, line, (size_t)length + 1);
+        size += (size_t)length;
+    }
+
+    free(output);
+    return size;
+}
+
+static size_t report_builder(size_t lines){
+    String_Builder sb;
+    sb_init(&sb);
+
+    for(size_t i = 0; i < lines; i++){
+        sb_appendf(&sb, "row %zu: name=%s value=%d\n", i, names[i % 8], (int)(i * 7 % 1000));
+    }
+
+    size_t size = sb.size;
+    char* output = sb_to_cstr(&sb);
+    free(output);
+    return size;
+}
+
+//Same report from pieces, no format string parsing at all
+static size_t report_builder_pieces(size_t lines){
+    String_Builder sb;
+    sb_init(&sb);
+
+    for(size_t i = 0; i < lines; i++){
+        sb_append_cstr(&sb, "row ");
+        sb_append_sv(&sb, sv_from_parts(names[i % 8], strlen(names[i % 8])));
+        sb_append_char(&sb, ':');
+        sb_append_char(&sb, '\n');
+    }
+
+    size_t size = sb.size;
+    sb_free(&sb);
+    return size;
+}
+
+//Short keys: malloc'd snprintf copies against builders that never leave their inline buffer
+static size_t keys_malloc(size_t count){
+    size_t total = 0;
+    for(size_t i = 0; i < count; i++){
+        char* key = (char*)malloc(32);
+        if(key == NULL) return total;
+        total += (size_t)snprintf(key, 32, "user:%zu:%s", i, names[i % 8]);
+        free(key);
+    }
+    return total;
+}
+
+static size_t keys_builder(size_t count){
+    size_t total = 0;
+    for(size_t i = 0; i < count; i++){
+        String_Builder sb;
+        sb_init(&sb);
+        sb_appendf(&sb, "user:%zu:%s", i, names[i % 8]);
+        total += sb_to_sv(&sb).size;
+        sb_free(&sb);
+    }
+    return total;
+}
+
+int main(int argc, char** argv){
+    size_t lines = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+    //strcat is quadratic, give it a slice and scale nothing: the rate already says enough
+    size_t strcat_lines = lines < 50000 ? lines : 50000;
+
+    uint64_t start = bench_now_ns();
+    size_t size = report_strcat(strcat_lines);
+    bench_report_bytes("report: strcat (50k lines max)", size, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    size = report_realloc(lines);
+    bench_report_bytes("report: snprintf + exact realloc", size, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    size = report_builder(lines);
+    bench_report_bytes("report: sb_appendf + sb_to_cstr", size, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    size = report_builder_pieces(lines);
+    bench_report_bytes("report: sb_append_cstr/sv/char", size, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    bench_keep(keys_malloc(lines));
+    bench_report_items("short keys: malloc + snprintf", lines, "keys", bench_now_ns() - start);
+
+    start = bench_now_ns();
+    bench_keep(keys_builder(lines));
+    bench_report_items("short keys: inline builder", lines, "keys", bench_now_ns() - start);
+
+    return 0;
+}
@@ -0,0 +1,262 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+//String_Map against a separately chained hash map (one malloc per node, same sv_hash) at a million keys.
+//Build: cc -O2 -std=gnu11 bench_string_map.c ../LibString/LibStringMap.c ../LibString/LibStringView.c ../LibArena/LibArena.c -o bench_string_map
+//Usage: bench_string_map [keys]
+
+#include "bench.h"
+#include "../LibString/LibStringMap.h"
+
+typedef struct Chained_Node
+{
+    struct Chained_Node* next;
+    uint64_t hash;
+    String_View key;
+    void* value;
+}Chained_Node;
+
+typedef struct
+{
+    Chained_Node** buckets;
+    size_t bucket_count;
+    size_t size;
+}Chained_Map;
+
+static bool chained_init(Chained_Map* map){
+    map->bucket_count = 16;
+    map->size = 0;
+    map->buckets = (Chained_Node**)calloc(map->bucket_count, sizeof(Chained_Node*));
+    return map->buckets != NULL;
+}
+
+static void chained_free(Chained_Map* map){
+    for(size_t i = 0; i < map->bucket_count; i++){
+        Chained_Node* node = map->buckets[i];
+        while(node != NULL){
+            Chained_Node* next = node->next;
+            free(node);
+            node = next;
+        }
+    }
+    free(map->buckets);
+}
+
+static bool chained_grow(Chained_Map* map){
+    size_t bucket_count = map->bucket_count * 2;
+    Chained_Node** buckets = (Chained_Node**)calloc(bucket_count, sizeof(Chained_Node*));
+    if(buckets == NULL) return false;
+
+    for(size_t i = 0; i < map->bucket_count; i++){
+        Chained_Node* node = map->buckets[i];
+        while(node != NULL){
+            Chained_Node* next = node->next;
+            size_t index = node->hash & (bucket_count - 1);
+            node->next = buckets[index];
+            buckets[index] = node;
+            node = next;
+        }
+    }
+
+    free(map->buckets);
+    map->buckets = buckets;
+    map->bucket_count = bucket_count;
+    return true;
+}
+
+static Chained_Node* chained_find(Chained_Map* map, String_View key, uint64_t hash){
+    Chained_Node* node = map->buckets[hash & (map->bucket_count - 1)];
+    while(node != NULL){
+        if(node->hash == hash && sv_cmp(node->key, key)) return node;
+        node = node->next;
+    }
+    return NULL;
+}
+
+static bool chained_put(Chained_Map* map, String_View key, void* value){
+    uint64_t hash = sv_hash(key);
+    Chained_Node* node = chained_find(map, key, hash);
+    if(node != NULL){
+        node->value = value;
+        return true;
+    }
+
+    if(map->size >= map->bucket_count && chained_grow(map) == false) return false;
+
+    node = (Chained_Node*)malloc(sizeof(Chained_Node));
+    if(node == NULL) return false;
+
+    size_t index = hash & (map->bucket_count - 1);
+    node->hash = hash;
+    node->key = key;
+    node->value = value;
+    node->next = map->buckets[index];
+    map->buckets[index] = node;
+    map->size++;
+    return true;
+}
+
+static void** chained_get(Chained_Map* map, String_View key){
+    Chained_Node* node = chained_find(map, key, sv_hash(key));
+    return node != NULL ? &node->value : NULL;
+}
+
+static bool chained_erase(Chained_Map* map, String_View key){
+    uint64_t hash = sv_hash(key);
+    Chained_Node** link = &map->buckets[hash & (map->bucket_count - 1)];
+    while(*link != NULL){
+        Chained_Node* node = *link;
+        if(node->hash == hash && sv_cmp(node->key, key)){
+            *link = node->next;
+            free(node);
+            map->size--;
+            return true;
+        }
+        link = &node->next;
+    }
+    return false;
+}
+
+static String_View* make_keys(size_t count, const char* prefix, char** storage){
+    String_View* keys = (String_View*)malloc(count * sizeof(String_View));
+    char* text = (char*)malloc(count * 32);
+    if(keys == NULL || text == NULL){
+        free(keys);
+        free(text);
+        return NULL;
+    }
+
+    size_t used = 0;
+    for(size_t i = 0; i < count; i++){
+        int written = snprintf(text + used, 32, "%s:%zu", prefix, i * 2654435761u % 1000000007u);
+        keys[i] = sv_from_parts(text + used, (size_t)written);
+        used += (size_t)written;
+    }
+
+    *storage = text;
+    return keys;
+}
+
+//Lookups in a different order than insertion so neither map is helped by recency
+static void shuffle(String_View* keys, size_t count){
+    uint64_t state = 88172645463325252ULL;
+    for(size_t i = count - 1; i > 0; i--){
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        size_t j = state % (i + 1);
+        String_View swap = keys[i];
+        keys[i] = keys[j];
+        keys[j] = swap;
+    }
+}
+
+int main(int argc, char** argv){
+    size_t count = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+
+    char* key_text = NULL;
+    char* miss_text = NULL;
+    String_View* keys = make_keys(count, "key", &key_text);
+    String_View* misses = make_keys(count, "missing", &miss_text);
+    String_View* lookups = (String_View*)malloc(count * sizeof(String_View));
+    if(keys == NULL || misses == NULL || lookups == NULL) return 1;
+    memcpy(lookups, keys, count * sizeof(String_View));
+    shuffle(lookups, count);
+
+    printf("%zu keys\n", count);
+
+    Chained_Map chained;
+    if(chained_init(&chained) == false) return 1;
+    String_Map map;
+    if(string_map_init(&map, false) == false) return 1;
+    String_Map reserved;
+    if(string_map_init(&reserved, false) == false) return 1;
+
+    uint64_t start = bench_now_ns();
+    for(size_t i = 0; i < count; i++) chained_put(&chained, keys[i], (void*)(uintptr_t)i);
+    bench_report_items("insert: chained", count, "ops", bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for(size_t i = 0; i < count; i++) string_map_put(&map, keys[i], (void*)(uintptr_t)i);
+    bench_report_items("insert: string_map", count, "ops", bench_now_ns() - start);
+
+    start = bench_now_ns();
+    string_map_reserve(&reserved, count);
+    for(size_t i = 0; i < count; i++) string_map_put(&reserved, keys[i], (void*)(uintptr_t)i);
+    bench_report_items("insert: string_map after reserve", count, "ops", bench_now_ns() - start);
+
+    size_t found = 0;
+    start = bench_now_ns();
+    for(size_t i = 0; i < count; i++) found += chained_get(&chained, lookups[i]) != NULL;
+    bench_report_items("hit: chained", count, "ops", bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for(size_t i = 0; i < count; i++) found += string_map_get(&map, lookups[i]) != NULL;
+    bench_report_items("hit: string_map", count, "ops", bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for(size_t i = 0; i < count; i++) found += chained_get(&chained, misses[i]) != NULL;
+    bench_report_items("miss: chained", count, "ops", bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for(size_t i = 0; i < count; i++) found += string_map_get(&map, misses[i]) != NULL;
+    bench_report_items("miss: string_map", count, "ops", bench_now_ns() - start);
+
+    if(found != 2 * count){
+        fprintf(stderr, "[ERROR] Expected %zu hits, got %zu\n", 2 * count, found);
+        return 1;
+    }
+
+    size_t visited = 0;
+    start = bench_now_ns();
+    for(size_t i = 0; i < chained.bucket_count; i++){
+        for(Chained_Node* node = chained.buckets[i]; node != NULL; node = node->next) visited += (uintptr_t)node->value & 1;
+    }
+    bench_report_items("iterate: chained", count, "entries", bench_now_ns() - start);
+
+    size_t iterator = 0;
+    String_Map_Entry* entry;
+    start = bench_now_ns();
+    while(string_map_next(&map, &iterator, &entry)) visited += (uintptr_t)entry->value & 1;
+    bench_report_items("iterate: string_map", count, "entries", bench_now_ns() - start);
+    bench_keep(visited);
+
+    start = bench_now_ns();
+    for(size_t i = 0; i < count; i += 2) chained_erase(&chained, lookups[i]);
+    bench_report_items("erase half: chained", count / 2, "ops", bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for(size_t i = 0; i < count; i += 2) string_map_erase(&map, lookups[i]);
+    bench_report_items("erase half: string_map", count / 2, "ops", bench_now_ns() - start);
+
+    chained_free(&chained);
+    string_map_free(&map);
+    string_map_free(&reserved);
+    free(keys);
+    free(misses);
+    free(lookups);
+    free(key_text);
+    free(miss_text);
+    return 0;
+}
@@ -0,0 +1,190 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+//Number parsing throughput: sv_parse_* against strtod/strtoull, and against the old
+//String_View route of sv_to_cstr followed by strtod.
+//Build: cc -O2 -std=gnu11 bench_sv_number.c ../LibString/LibStringNumber.c ../LibString/LibStringView.c ../LibArena/LibArena.c -o bench_sv_number
+//Usage: bench_sv_number [numbers]
+
+#include "bench.h"
+#include "../LibString/LibStringNumber.h"
+
+typedef enum {
+    NUMBERS_INTEGERS,
+    NUMBERS_SHORT_DECIMALS,
+    NUMBERS_FULL_DOUBLES
+}Numbers_Kind;
+
+static uint64_t bench_random(uint64_t* state){
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+//Comma separated numbers, NUL terminated so strtod can run on the same buffer
+static char* make_numbers(Numbers_Kind kind, size_t count, size_t* size){
+    size_t capacity = count * 32 + 1;
+    char* text = (char*)malloc(capacity);
+    if(text == NULL) return NULL;
+
+    uint64_t state = 88172645463325252ULL;
+    size_t used = 0;
+    for(size_t i = 0; i < count; i++){
+        uint64_t bits = bench_random(&state);
+        switch(kind){
+            case NUMBERS_INTEGERS:
+                used += (size_t)snprintf(text + used, capacity - used, "%llu,", (unsigned long long)(bits >> (bits % 64)));
+                break;
+
+            case NUMBERS_SHORT_DECIMALS:
+                used += (size_t)snprintf(text + used, capacity - used, "%.3f,", (double)(bits % 10000000) / 100.0);
+                break;
+
+            case NUMBERS_FULL_DOUBLES: {
+                //Random magnitudes across the whole exponent range, printed round-trip exact
+                double value = (double)(bits >> 11) / 9007199254740992.0;
+                int exponent = (int)(bench_random(&state) % 600) - 300;
+                used += (size_t)snprintf(text + used, capacity - used, "%.17ge%d,", value, exponent);
+                break;
+            }
+        }
+    }
+
+    text[used] = '\0';
+    *size = used;
+    return text;
+}
+
+static double sum_strtod(const char* text){
+    double sum = 0;
+    char* end;
+    while(*text != '\0'){
+        sum += strtod(text, &end);
+        text = end + 1;
+    }
+    return sum;
+}
+
+static double sum_cstr_strtod(String_View sv){
+    double sum = 0;
+    String_View field;
+    Sv_Split split = sv_split(sv);
+    while(sv_split_next(&split, ',', &field)){
+        if(field.size == 0) continue;
+        char* copy = sv_to_cstr(field);
+        if(copy == NULL) break;
+        sum += strtod(copy, NULL);
+        free(copy);
+    }
+    return sum;
+}
+
+static double sum_sv_double(String_View sv){
+    double sum = 0;
+    while(sv.size > 0){
+        double value;
+        size_t consumed = sv_parse_double(sv, &value);
+        if(consumed == 0) break;
+        sum += value;
+        sv.string += consumed + 1;
+        sv.size -= consumed + 1;
+    }
+    return sum;
+}
+
+static uint64_t sum_strtoull(const char* text){
+    uint64_t sum = 0;
+    char* end;
+    while(*text != '\0'){
+        sum += strtoull(text, &end, 10);
+        text = end + 1;
+    }
+    return sum;
+}
+
+static uint64_t sum_sv_u64(String_View sv){
+    uint64_t sum = 0;
+    while(sv.size > 0){
+        uint64_t value;
+        size_t consumed = sv_parse_u64(sv, &value);
+        if(consumed == 0) break;
+        sum += value;
+        sv.string += consumed + 1;
+        sv.size -= consumed + 1;
+    }
+    return sum;
+}
+
+int main(int argc, char** argv){
+    size_t count = argc > 1 ? strtoul(argv[1], NULL, 10) : 2000000;
+    const char* kind_names[] = {"integers", "short decimals (%.3f)", "full doubles (%.17g)"};
+
+    printf("%zu numbers per run\n", count);
+
+    for(int kind = NUMBERS_INTEGERS; kind <= NUMBERS_FULL_DOUBLES; kind++){
+        size_t size = 0;
+        char* text = make_numbers((Numbers_Kind)kind, count, &size);
+        if(text == NULL) return 1;
+        String_View sv = sv_from_parts(text, size);
+
+        printf("\n%s, %.1f MB\n", kind_names[kind], (double)size / (1024.0 * 1024.0));
+
+        uint64_t start;
+        if(kind == NUMBERS_INTEGERS){
+            start = bench_now_ns();
+            uint64_t expected = sum_strtoull(text);
+            bench_report_items("strtoull", count, "numbers", bench_now_ns() - start);
+
+            start = bench_now_ns();
+            uint64_t sum = sum_sv_u64(sv);
+            bench_report_items("sv_parse_u64", count, "numbers", bench_now_ns() - start);
+
+            if(sum != expected) printf("sv_parse_u64 disagrees with strtoull\n");
+        }
+
+        start = bench_now_ns();
+        double expected = sum_strtod(text);
+        bench_report_items("strtod", count, "numbers", bench_now_ns() - start);
+
+        start = bench_now_ns();
+        double copied = sum_cstr_strtod(sv);
+        bench_report_items("sv_to_cstr + strtod", count, "numbers", bench_now_ns() - start);
+
+        start = bench_now_ns();
+        double sum = sum_sv_double(sv);
+        uint64_t elapsed = bench_now_ns() - start;
+        bench_report_items("sv_parse_double", count, "numbers", elapsed);
+        bench_report_bytes("sv_parse_double", size, elapsed);
+
+        //Correct rounding means the very same doubles, so the sums match bit for bit
+        if(memcmp(&sum, &expected, sizeof(double)) != 0 || memcmp(&copied, &expected, sizeof(double)) != 0){
+            printf("sv_parse_double disagrees with strtod\n");
+        }
+
+        free(text);
+    }
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+//String_View equality and search kernels against the byte loop they replaced and against libc.
+//Build: cc -O2 -std=gnu11 bench_sv_search.c ../LibString/LibStringView.c ../LibArena/LibArena.c -o bench_sv_search
+//Usage: bench_sv_search [MB per measurement]
+
+#include "bench.h"
+#include "../LibString/LibStringView.h"
+
+//The loops sv_cmp and the parsers used before the kernels existed
+static bool loop_equal(String_View a, String_View b){
+    if(a.size != b.size) return false;
+    for(size_t i = 0; i < a.size; i++){
+        if(a.string[i] != b.string[i]) return false;
+    }
+    return true;
+}
+
+static size_t loop_find_char(String_View sv, char c){
+    for(size_t i = 0; i < sv.size; i++){
+        if(sv.string[i] == c) return i;
+    }
+    return sv.size;
+}
+
+static size_t loop_find_any(String_View sv, String_View set){
+    for(size_t i = 0; i < sv.size; i++){
+        for(size_t j = 0; j < set.size; j++){
+            if(sv.string[i] == set.string[j]) return i;
+        }
+    }
+    return sv.size;
+}
+
+static size_t loop_find(String_View sv, String_View needle){
+    if(needle.size > sv.size) return sv.size;
+    for(size_t i = 0; i + needle.size <= sv.size; i++){
+        if(memcmp(sv.string + i, needle.string, needle.size) == 0) return i;
+    }
+    return sv.size;
+}
+
+static size_t libc_find(String_View sv, String_View needle){
+    const char* found = (const char*)memmem(sv.string, sv.size, needle.string, needle.size);
+    return found == NULL ? sv.size : (size_t)(found - sv.string);
+}
+
+int main(int argc, char** argv){
+    size_t total = (argc > 1 ? strtoul(argv[1], NULL, 10) : 256) * 1024 * 1024;
+    const size_t sizes[] = {16, 64, 256, 4096, 1024 * 1024};
+    const char needle_text[] = "qq#qq";
+
+    for(size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++){
+        size_t size = sizes[s];
+        size_t rounds = total / size;
+
+        //The match sits at the very end, so every call scans the whole view
+        char* haystack = (char*)malloc(size + 1);
+        char* copy = (char*)malloc(size + 1);
+        if(haystack == NULL || copy == NULL) return 1;
+        bench_fill_text(haystack, size, 3);
+        memcpy(haystack + size - (sizeof(needle_text) - 1), needle_text, sizeof(needle_text) - 1);
+        haystack[size] = '\0';
+        memcpy(copy, haystack, size + 1);
+
+        String_View sv = sv_from_parts(haystack, size);
+        String_View other = sv_from_parts(copy, size);
+        String_View set = sv_from_parts("#@!", 3);
+        String_View needle = sv_from_parts(needle_text, sizeof(needle_text) - 1);
+
+        printf("\n%zu byte views\n", size);
+
+        BENCH_RUN("equal: byte loop", size, rounds, loop_equal(sv, other));
+        BENCH_RUN("equal: memcmp", size, rounds, memcmp(haystack, copy, size) == 0);
+        BENCH_RUN("equal: sv_cmp", size, rounds, sv_cmp(sv, other));
+
+        BENCH_RUN("prefix: sv_starts_with (whole view)", size, rounds, sv_starts_with(sv, other));
+        BENCH_RUN("suffix: sv_ends_with (whole view)", size, rounds, sv_ends_with(sv, other));
+
+        BENCH_RUN("find char: byte loop", size, rounds, loop_find_char(sv, '#'));
+        BENCH_RUN("find char: memchr", size, rounds, (uintptr_t)memchr(haystack, '#', size));
+        BENCH_RUN("find char: sv_find_char", size, rounds, sv_find_char(sv, '#'));
+
+        BENCH_RUN("find any of 3: byte loop", size, rounds, loop_find_any(sv, set));
+        BENCH_RUN("find any of 3: strcspn", size, rounds, strcspn(haystack, "#@!"));
+        BENCH_RUN("find any of 3: sv_find_any", size, rounds, sv_find_any(sv, set));
+
+        BENCH_RUN("substring: memcmp loop", size, rounds, loop_find(sv, needle));
+        BENCH_RUN("substring: memmem", size, rounds, libc_find(sv, needle));
+        BENCH_RUN("substring: sv_find", size, rounds, sv_find(sv, needle));
+
+        free(haystack);
+        free(copy);
+    }
+
+    return 0;
+}
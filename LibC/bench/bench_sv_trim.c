@@ -0,0 +1,149 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+//sv_trim against the isspace loops it replaced, on long padded lines and on a mapped file whose
+//last line runs into the end of the mapping with no terminator after it.
+//Build: cc -O2 -std=gnu11 bench_sv_trim.c ../LibFile/LibFile.c ../LibString/LibStringView.c ../LibArena/LibArena.c -o bench_sv_trim
+//Usage: bench_sv_trim [MB per measurement]
+
+#include "bench.h"
+#include "../LibFile/LibFile.h"
+
+#include <ctype.h>
+
+#define BENCH_FILE "bench_sv_trim.tmp"
+#define BENCH_LINE_SIZE (64 * 1024)
+#define BENCH_PADDING 1024
+#define BENCH_FILE_SIZE (64 * 1024 * 1024)
+
+//The old sv_trim_left: isspace twice per byte, then strlen on whatever follows the spaces
+static String_View old_trim_left(String_View sv){
+    size_t space_counter = 0;
+
+    for(size_t i = 0; i < sv.size; i++){
+        if(isspace(sv.string[i]) != 0) space_counter++;
+        if(isspace(sv.string[i]) == 0) break;
+    }
+
+    return sv_append(&sv.string[space_counter]);
+}
+
+//A bounded isspace loop, what a careful caller would write without the kernels
+static String_View loop_trim(String_View sv){
+    size_t start = 0;
+    while(start < sv.size && isspace((unsigned char)sv.string[start])) start++;
+
+    size_t end = sv.size;
+    while(end > start && isspace((unsigned char)sv.string[end - 1])) end--;
+
+    return sv_from_parts(sv.string + start, end - start);
+}
+
+static size_t trim_lines_loop(String_View data){
+    size_t kept = 0;
+    String_View line;
+    Sv_Split split = sv_split(data);
+    while(sv_split_next_line(&split, &line)) kept += loop_trim(line).size;
+    return kept;
+}
+
+static size_t trim_lines_sv(String_View data){
+    size_t kept = 0;
+    String_View line;
+    Sv_Split split = sv_split(data);
+    while(sv_split_next_line(&split, &line)) kept += sv_trim(line).size;
+    return kept;
+}
+
+//Lines padded with runs of spaces and tabs on both sides, the file ends in padding with no newline
+static bool make_padded_file(const char* file, size_t size){
+    char* buffer = (char*)malloc(size);
+    if(buffer == NULL) return false;
+
+    bench_fill_text(buffer, size, 11);
+    size_t line_start = 0;
+    for(size_t i = 0; i < size; i++){
+        if(buffer[i] != '\n' && i + 1 != size) continue;
+
+        size_t length = i - line_start;
+        size_t pad = length / 4;
+        memset(buffer + line_start, ' ', pad);
+        memset(buffer + i - pad, '\t', pad);
+        if(i + 1 == size) buffer[i] = ' ';
+        line_start = i + 1;
+    }
+
+    FILE* output = fopen(file, "wb");
+    bool written = output != NULL && fwrite(buffer, 1, size, output) == size;
+    if(output != NULL && fclose(output) != 0) written = false;
+
+    free(buffer);
+    return written;
+}
+
+int main(int argc, char** argv){
+    size_t total = (argc > 1 ? strtoul(argv[1], NULL, 10) : 256) * 1024 * 1024;
+
+    //One long line, padded on both sides and NUL terminated so the old trim can run on it
+    char* line = (char*)malloc(BENCH_LINE_SIZE + 1);
+    if(line == NULL) return 1;
+    bench_fill_text(line, BENCH_LINE_SIZE, 5);
+    for(size_t i = 0; i < BENCH_LINE_SIZE; i++){
+        if(line[i] == '\n') line[i] = ' ';
+    }
+    memset(line, ' ', BENCH_PADDING);
+    memset(line + BENCH_LINE_SIZE - BENCH_PADDING, '\t', BENCH_PADDING);
+    line[BENCH_LINE_SIZE] = '\0';
+
+    String_View sv = sv_from_parts(line, BENCH_LINE_SIZE);
+    size_t rounds = total / BENCH_PADDING;
+
+    //Rates count the padding only, that is all a trim should have to look at
+    printf("%d KB line with %d bytes of padding on each side (MB/s of padding trimmed)\n", BENCH_LINE_SIZE / 1024, BENCH_PADDING);
+    BENCH_RUN("trim left: old (isspace + strlen)", BENCH_PADDING, rounds, old_trim_left(sv).size);
+    BENCH_RUN("trim left: bounded isspace loop", BENCH_PADDING, rounds, loop_trim(sv_from_parts(sv.string, BENCH_LINE_SIZE - BENCH_PADDING)).size);
+    BENCH_RUN("trim left: sv_trim_left", BENCH_PADDING, rounds, sv_trim_left(sv).size);
+    BENCH_RUN("trim both: bounded isspace loop", 2 * BENCH_PADDING, rounds, loop_trim(sv).size);
+    BENCH_RUN("trim both: sv_trim", 2 * BENCH_PADDING, rounds, sv_trim(sv).size);
+    free(line);
+
+    if(make_padded_file(BENCH_FILE, BENCH_FILE_SIZE) == false){
+        fprintf(stderr, "[ERROR] Could not create %s\n", BENCH_FILE);
+        return 1;
+    }
+
+    Mapped_File mapped_file;
+    if(map_file(&mapped_file, BENCH_FILE, false) == false) return 1;
+    String_View data = mapped_file_to_sv(mapped_file);
+
+    //The file size is a page multiple, reading one byte past the view would fault
+    printf("\n%d MB mapped file, every line trimmed, last line ends at the mapping edge\n", BENCH_FILE_SIZE / (1024 * 1024));
+    printf("%-40s %10s\n", "old trim: needs a terminator", "skipped");
+    BENCH_RUN("per line: bounded isspace loop", data.size, 4, trim_lines_loop(data));
+    BENCH_RUN("per line: sv_trim", data.size, 4, trim_lines_sv(data));
+
+    unmap_file(&mapped_file);
+    remove(BENCH_FILE);
+    return 0;
+}
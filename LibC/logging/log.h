@@ -24,6 +24,13 @@
 
 #pragma once
 
+//The Linux implementation needs POSIX/GNU declarations (syscall, clock_gettime, localtime_r, O_CLOEXEC).
+//They are requested here, which only works when log.h is the first include of the file defining
+//LIB_LOG_IMPLEMENTATION. Otherwise define _GNU_SOURCE yourself or build with -std=gnu11.
+#if defined(LIB_LOG_IMPLEMENTATION) && defined(__linux__) && !defined(_GNU_SOURCE)
+    #define _GNU_SOURCE
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdarg.h>
@@ -50,6 +57,71 @@ typedef enum {
     Custom
 }LogType;
 
+#define LOG_LEVEL_DEBUG    0
+#define LOG_LEVEL_INFO     1
+#define LOG_LEVEL_SUCCESS  2
+#define LOG_LEVEL_WARNING  3
+#define LOG_LEVEL_ERROR    4
+#define LOG_LEVEL_CRITICAL 5
+#define LOG_LEVEL_OFF      6
+
+//Calls below LOG_MIN_LEVEL are removed at compile time, arguments included
+#ifndef LOG_MIN_LEVEL
+    #define LOG_MIN_LEVEL LOG_LEVEL_DEBUG
+#endif
+
+//Safe to call while other threads log, the level itself lives in the implementation section
+void log_set_level(int level);
+int log_get_level(void);
+
+#define log_level_enabled(level) ((level) >= LOG_MIN_LEVEL && (level) >= log_get_level())
+
+//With LOG_WITH_LOCATION defined the LOG_* macros also report __FILE__, __LINE__ and __func__
+#if defined(LOG_WITH_LOCATION) && defined(__linux__)
+    #define __internal_log_call(function, level, ...) log_at(level, __FILE__, __LINE__, __func__, __VA_ARGS__)
+#else
+    #define __internal_log_call(function, level, ...) function(__VA_ARGS__)
+#endif
+
+//if(0) keeps disabled calls type-checked while the compiler drops them and their arguments
+#define __internal_log_disabled(function, ...) do { if(0) function(__VA_ARGS__); } while(0)
+#define __internal_log_enabled(function, level, ...) do { \
+        if((level) >= log_get_level()) __internal_log_call(function, level, __VA_ARGS__); \
+    } while(0)
+
+#if LOG_MIN_LEVEL <= LOG_LEVEL_DEBUG
+    #define LOG_DEBUG(...) __internal_log_enabled(debug, LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+    #define LOG_DEBUG(...) __internal_log_disabled(debug, __VA_ARGS__)
+#endif
+
+#if LOG_MIN_LEVEL <= LOG_LEVEL_INFO
+    #define LOG_INFO(...) __internal_log_enabled(info, LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+    #define LOG_INFO(...) __internal_log_disabled(info, __VA_ARGS__)
+#endif
+
+#if LOG_MIN_LEVEL <= LOG_LEVEL_SUCCESS
+    #define LOG_OKAY(...) __internal_log_enabled(okay, LOG_LEVEL_SUCCESS, __VA_ARGS__)
+#else
+    #define LOG_OKAY(...) __internal_log_disabled(okay, __VA_ARGS__)
+#endif
+
+#if LOG_MIN_LEVEL <= LOG_LEVEL_WARNING
+    #define LOG_WARNING(...) __internal_log_enabled(warning, LOG_LEVEL_WARNING, __VA_ARGS__)
+#else
+    #define LOG_WARNING(...) __internal_log_disabled(warning, __VA_ARGS__)
+#endif
+
+#if LOG_MIN_LEVEL <= LOG_LEVEL_ERROR
+    #define LOG_ERROR(...) __internal_log_enabled(error, LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+    #define LOG_ERROR(...) __internal_log_disabled(error, __VA_ARGS__)
+#endif
+
+//critical() aborts, so it is never compiled out: only its message is subject to the levels
+#define LOG_CRITICAL(...) __internal_log_call(critical, LOG_LEVEL_CRITICAL, __VA_ARGS__)
+
 ///
 ///End Macro section
 ///
@@ -71,6 +143,117 @@ typedef enum {
     void critical(const char* format, ...);
 
     void log_file(LogType type, const char* file,  const char* format, ...);
+    void log_at(int level, const char* file, int line, const char* function, const char* format, ...);
+
+    #include <stdbool.h>
+    #include <pthread.h>
+
+    typedef enum {
+        LogAsyncBlock = 0,
+        LogAsyncDrop,
+        LogAsyncOverwrite
+    }LogAsyncPolicy;
+
+    //Records longer than this are truncated in async mode
+    #define LOG_ASYNC_RECORD_SIZE 512
+    #define LOG_ASYNC_DEFAULT_CAPACITY 4096
+
+    //Lines longer than this are formatted into a temporary heap buffer
+    #define LOG_LINE_SIZE 4096
+
+    void log_set_timestamps(bool enabled);
+    void log_set_thread_ids(bool enabled);
+
+    bool log_async_start(size_t capacity, LogAsyncPolicy policy);
+    void log_async_flush(void);
+    void log_async_stop(void);
+    size_t log_async_dropped(void);
+
+    #define LOG_SINK_DEFAULT_BUFFER_SIZE (64 * 1024)
+    #define LOG_SINK_FLUSH_ON(type) (1u << (type))
+
+    typedef struct {
+        size_t buffer_size;
+        //Buffered records are written out at most this long after the buffer was last empty,
+        //a background thread takes care of it when the sink receives no further writes
+        unsigned flush_interval_ms;
+        unsigned flush_on;
+        size_t rotate_size;
+        unsigned rotate_interval_s;
+    }LogSinkConfig;
+
+    typedef struct {
+        int fd;
+        char* path;
+        char* buffer;
+        size_t capacity;
+        size_t used;
+        size_t file_size;
+        unsigned long long last_flush_ms;
+        unsigned long long opened_at_ms;
+        LogSinkConfig config;
+        pthread_mutex_t lock;
+        pthread_cond_t wake;
+        pthread_t flusher;
+        bool flusher_running;
+        bool closing;
+    }LogSink;
+
+    bool log_sink_open(LogSink* sink, const char* file, LogSinkConfig config);
+    void log_sink_write(LogSink* sink, LogType type, const char* format, ...);
+    bool log_sink_flush(LogSink* sink);
+    bool log_sink_rotate(LogSink* sink);
+    void log_sink_close(LogSink* sink);
+
+    #include <stdint.h>
+
+    #define LOG_BINARY_MAGIC "LOGB"
+    #define LOG_BINARY_VERSION 1
+    #define LOG_BINARY_MAX_FORMATS 4096
+    #define LOG_BINARY_MAX_ARGS 32
+    #define LOG_BINARY_MAX_STRING 4096
+    #define LOG_BINARY_DEFAULT_BUFFER_SIZE (64 * 1024)
+
+    #define LOG_BINARY_KIND_FORMAT 'F'
+    #define LOG_BINARY_KIND_RECORD 'R'
+
+    typedef enum {
+        LogBinaryArgInt = 0,
+        LogBinaryArgLong,
+        LogBinaryArgLongLong,
+        LogBinaryArgSize,
+        LogBinaryArgIntMax,
+        LogBinaryArgPtrDiff,
+        LogBinaryArgDouble,
+        LogBinaryArgString,
+        LogBinaryArgPointer
+    }LogBinaryArg;
+
+    typedef struct {
+        uint8_t count;
+        uint8_t args[LOG_BINARY_MAX_ARGS];
+    }LogBinaryFormat;
+
+    typedef struct {
+        int fd;
+        char* buffer;
+        size_t capacity;
+        size_t used;
+        //Published with a release store once formats[id] is filled, writers read it without the lock.
+        //Plain type plus __atomic builtins so C++ code can still include this header.
+        uint16_t format_count;
+        LogBinaryFormat* formats;
+        pthread_mutex_t lock;
+    }LogBinary;
+
+    //The stream is written in host byte order: decode it on a machine with the same endianness
+    bool log_binary_open(LogBinary* log, const char* file, size_t buffer_size);
+    int log_binary_register(LogBinary* log, const char* format);
+    void log_binary_write(LogBinary* log, LogType type, int format_id, ...);
+    bool log_binary_flush(LogBinary* log);
+    void log_binary_close(LogBinary* log);
+
+    const char* log_binary_next_spec(const char* format, const char** spec, size_t* spec_size, LogBinaryArg* arg, int* stars);
 
 #elif defined(WINDOWS)
 /*
@@ -136,8 +319,429 @@ typedef enum {
 #ifdef LIB_LOG_IMPLEMENTATION
 
 #ifdef __linux__
+
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <stddef.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+typedef struct
+{
+    atomic_size_t sequence;
+    size_t size;
+    char text[LOG_ASYNC_RECORD_SIZE];
+}LogAsyncSlot;
+
+typedef struct
+{
+    LogAsyncSlot* slots;
+    char* batch;
+    size_t mask;
+    LogAsyncPolicy policy;
+    atomic_bool running;
+    atomic_bool stopping;
+    atomic_bool sleeping;
+    atomic_size_t enqueue_pos;
+    atomic_size_t dequeue_pos;
+    atomic_size_t completed;
+    atomic_size_t dropped;
+    atomic_size_t producers;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+}LogAsyncState;
+
+static LogAsyncState log_async_state = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .wake = PTHREAD_COND_INITIALIZER,
+};
+
+#define LOG_ASYNC_BATCH_SIZE (64 * 1024)
+
+static void __internal_log_write_all(int fd, const char* data, size_t size)
+{
+    while(size > 0){
+        ssize_t written = write(fd, data, size);
+        if(written < 0){
+            if(errno == EINTR) continue;
+            return;
+        }
+        data += written;
+        size -= (size_t)written;
+    }
+}
+
+static bool log_timestamps = false;
+static bool log_thread_ids = false;
+static __thread uint32_t log_thread_id = 0;
+
+void log_set_timestamps(bool enabled)
+{
+    log_timestamps = enabled;
+}
+
+void log_set_thread_ids(bool enabled)
+{
+    log_thread_ids = enabled;
+}
+
+static uint32_t __internal_log_thread_id(void)
+{
+    if(log_thread_id == 0) log_thread_id = (uint32_t)syscall(SYS_gettid);
+    return log_thread_id;
+}
+
+//Writes "<color>[LABEL]<reset> [timestamp] [tid] location" and returns its length, clamped to size - 1
+static size_t __internal_log_format_header(char* out, size_t size, const char* color, const char* label, const char* location)
+{
+    char stamp[48] = "";
+    char thread[24] = "";
+
+    if(log_timestamps){
+        struct timespec now;
+        clock_gettime(CLOCK_REALTIME, &now);
+
+        struct tm local;
+        localtime_r(&now.tv_sec, &local);
+
+        size_t used = strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%S", &local);
+        snprintf(stamp + used, sizeof(stamp) - used, ".%09ld ", (long)now.tv_nsec);
+    }
+
+    if(log_thread_ids){
+        snprintf(thread, sizeof(thread), "[%u] ", __internal_log_thread_id());
+    }
+
+    int header = snprintf(out, size, "%s[%s]%s %s%s%s", color, label, LOG_COLOR_RESET, stamp, thread, location);
+    if(header < 0) return 0;
+
+    return (size_t)header < size ? (size_t)header : size - 1;
+}
+
+//Claims the slot at the head of the ring, the caller releases it with __internal_log_async_release.
+//With must_deliver set a full ring is waited on whatever the policy, so the record is never dropped.
+static LogAsyncSlot* __internal_log_async_claim(size_t* position, bool must_deliver)
+{
+    size_t pos = atomic_load_explicit(&log_async_state.enqueue_pos, memory_order_relaxed);
+
+    for(;;){
+        LogAsyncSlot* slot = &log_async_state.slots[pos & log_async_state.mask];
+        size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+
+        if(diff == 0){
+            if(atomic_compare_exchange_weak_explicit(&log_async_state.enqueue_pos, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed)){
+                *position = pos;
+                return slot;
+            }
+            continue;
+        }
+
+        if(diff > 0){
+            pos = atomic_load_explicit(&log_async_state.enqueue_pos, memory_order_relaxed);
+            continue;
+        }
+
+        //Ring is full
+        switch(must_deliver ? LogAsyncBlock : log_async_state.policy){
+            case LogAsyncDrop:
+                atomic_fetch_add_explicit(&log_async_state.dropped, 1, memory_order_relaxed);
+                return NULL;
+
+            case LogAsyncOverwrite: {
+                //Discard the oldest record on behalf of the consumer
+                size_t tail = atomic_load_explicit(&log_async_state.dequeue_pos, memory_order_relaxed);
+                LogAsyncSlot* oldest = &log_async_state.slots[tail & log_async_state.mask];
+                size_t oldest_sequence = atomic_load_explicit(&oldest->sequence, memory_order_acquire);
+
+                if(oldest_sequence == tail + 1 &&
+                   atomic_compare_exchange_strong_explicit(&log_async_state.dequeue_pos, &tail, tail + 1, memory_order_relaxed, memory_order_relaxed)){
+                    atomic_store_explicit(&oldest->sequence, tail + log_async_state.mask + 1, memory_order_release);
+                    atomic_fetch_add_explicit(&log_async_state.dropped, 1, memory_order_relaxed);
+                    atomic_fetch_add_explicit(&log_async_state.completed, 1, memory_order_release);
+                }
+                break;
+            }
+
+            case LogAsyncBlock:
+            default:
+                sched_yield();
+                break;
+        }
+
+        pos = atomic_load_explicit(&log_async_state.enqueue_pos, memory_order_relaxed);
+    }
+}
+
+static void __internal_log_async_release(LogAsyncSlot* slot, size_t position)
+{
+    atomic_store_explicit(&slot->sequence, position + 1, memory_order_release);
+
+    if(atomic_load_explicit(&log_async_state.sleeping, memory_order_relaxed)){
+        pthread_mutex_lock(&log_async_state.lock);
+        pthread_cond_signal(&log_async_state.wake);
+        pthread_mutex_unlock(&log_async_state.lock);
+    }
+}
+
+static void __internal_log_async_push(int level, const char* color, const char* label, const char* location, const char* format, va_list args)
+{
+    size_t position;
+    LogAsyncSlot* slot = __internal_log_async_claim(&position, level >= LOG_LEVEL_ERROR);
+    if(slot == NULL) return;
+
+    size_t prefix = __internal_log_format_header(slot->text, sizeof(slot->text), color, label, location);
+
+    int body = vsnprintf(slot->text + prefix, sizeof(slot->text) - prefix, format, args);
+    if(body < 0) body = 0;
+
+    size_t size = prefix + (size_t)body;
+    if(size >= sizeof(slot->text)){
+        //Truncation cuts the line terminator, put it back so the next record starts on its own line
+        size = sizeof(slot->text) - 1;
+        size_t format_size = strlen(format);
+        if(format_size > 0 && format[format_size - 1] == '\n') slot->text[size - 1] = '\n';
+    }
+    slot->size = size;
+
+    __internal_log_async_release(slot, position);
+}
+
+static bool __internal_log_async_pop(char* batch, size_t* batch_size)
+{
+    size_t pos = atomic_load_explicit(&log_async_state.dequeue_pos, memory_order_relaxed);
+
+    for(;;){
+        LogAsyncSlot* slot = &log_async_state.slots[pos & log_async_state.mask];
+        size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+
+        if(diff < 0) return false;
+
+        if(diff > 0){
+            pos = atomic_load_explicit(&log_async_state.dequeue_pos, memory_order_relaxed);
+            continue;
+        }
+
+        if(atomic_compare_exchange_weak_explicit(&log_async_state.dequeue_pos, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed)){
+            memcpy(batch + *batch_size, slot->text, slot->size);
+            *batch_size += slot->size;
+            atomic_store_explicit(&slot->sequence, pos + log_async_state.mask + 1, memory_order_release);
+            return true;
+        }
+    }
+}
+
+static void* __internal_log_async_consumer(void* arg)
+{
+    (void)arg;
+    char* batch = log_async_state.batch;
+
+    for(;;){
+        size_t batch_size = 0;
+        size_t records = 0;
+
+        while(batch_size + LOG_ASYNC_RECORD_SIZE <= LOG_ASYNC_BATCH_SIZE && __internal_log_async_pop(batch, &batch_size)){
+            records++;
+        }
+
+        if(records > 0){
+            __internal_log_write_all(STDOUT_FILENO, batch, batch_size);
+            atomic_fetch_add_explicit(&log_async_state.completed, records, memory_order_release);
+            continue;
+        }
+
+        if(atomic_load_explicit(&log_async_state.stopping, memory_order_acquire)) break;
+
+        //Timed wait so a wakeup lost between the empty check and the sleep only costs a millisecond
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += 1000000;
+        if(deadline.tv_nsec >= 1000000000){
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000;
+        }
+
+        pthread_mutex_lock(&log_async_state.lock);
+        atomic_store_explicit(&log_async_state.sleeping, true, memory_order_relaxed);
+        pthread_cond_timedwait(&log_async_state.wake, &log_async_state.lock, &deadline);
+        atomic_store_explicit(&log_async_state.sleeping, false, memory_order_relaxed);
+        pthread_mutex_unlock(&log_async_state.lock);
+    }
+
+    return NULL;
+}
+
+bool log_async_start(size_t capacity, LogAsyncPolicy policy)
+{
+    if(atomic_load(&log_async_state.running)) return true;
+
+    if(capacity == 0) capacity = LOG_ASYNC_DEFAULT_CAPACITY;
+
+    //The ring indexes with a mask, round the capacity up to a power of two
+    size_t slots = 2;
+    while(slots < capacity) slots <<= 1;
+
+    //The consumer batch is allocated here so the thread cannot fail once the ring is live
+    LogAsyncSlot* ring = (LogAsyncSlot*)malloc(slots * sizeof(LogAsyncSlot));
+    char* batch = (char*)malloc(LOG_ASYNC_BATCH_SIZE);
+    if(ring == NULL || batch == NULL){
+        fprintf(stderr, "[ERROR] Could not allocate memory\n");
+        free(ring);
+        free(batch);
+        return false;
+    }
+
+    for(size_t i = 0; i < slots; i++){
+        atomic_init(&ring[i].sequence, i);
+    }
+
+    log_async_state.slots = ring;
+    log_async_state.batch = batch;
+    log_async_state.mask = slots - 1;
+    log_async_state.policy = policy;
+    atomic_store(&log_async_state.enqueue_pos, 0);
+    atomic_store(&log_async_state.dequeue_pos, 0);
+    atomic_store(&log_async_state.completed, 0);
+    atomic_store(&log_async_state.dropped, 0);
+    atomic_store(&log_async_state.stopping, false);
+
+    //Records already buffered by stdio must come out before the async ones
+    fflush(stdout);
+
+    if(pthread_create(&log_async_state.thread, NULL, __internal_log_async_consumer, NULL) != 0){
+        fprintf(stderr, "[ERROR] Could not start the log thread\n");
+        free(ring);
+        free(batch);
+        log_async_state.slots = NULL;
+        log_async_state.batch = NULL;
+        return false;
+    }
+
+    atomic_store_explicit(&log_async_state.running, true, memory_order_release);
+    return true;
+}
+
+void log_async_flush(void)
+{
+    if(atomic_load_explicit(&log_async_state.running, memory_order_acquire) == false){
+        fflush(stdout);
+        return;
+    }
+
+    size_t target = atomic_load_explicit(&log_async_state.enqueue_pos, memory_order_relaxed);
+
+    pthread_mutex_lock(&log_async_state.lock);
+    pthread_cond_signal(&log_async_state.wake);
+    pthread_mutex_unlock(&log_async_state.lock);
+
+    while(atomic_load_explicit(&log_async_state.completed, memory_order_acquire) < target){
+        sched_yield();
+    }
+}
+
+void log_async_stop(void)
+{
+    if(atomic_load(&log_async_state.running) == false) return;
+
+    //New records go straight to stdout from here on, the ones already being pushed
+    //are waited for so the consumer drains them before the ring is released
+    atomic_store(&log_async_state.running, false);
+    while(atomic_load(&log_async_state.producers) > 0){
+        sched_yield();
+    }
+
+    atomic_store_explicit(&log_async_state.stopping, true, memory_order_release);
+
+    pthread_mutex_lock(&log_async_state.lock);
+    pthread_cond_signal(&log_async_state.wake);
+    pthread_mutex_unlock(&log_async_state.lock);
+
+    pthread_join(log_async_state.thread, NULL);
+
+    free(log_async_state.slots);
+    free(log_async_state.batch);
+    log_async_state.slots = NULL;
+    log_async_state.batch = NULL;
+}
+
+size_t log_async_dropped(void)
+{
+    return atomic_load_explicit(&log_async_state.dropped, memory_order_relaxed);
+}
+
+static void __internal_log_emit(int level, const char* color, const char* label, const char* location, const char* format, va_list args)
+{
+    //The producer count is raised before running is checked, log_async_stop clears running
+    //before waiting on the count: a producer either sees the ring stopped or is waited for
+    atomic_fetch_add(&log_async_state.producers, 1);
+
+    if(atomic_load(&log_async_state.running)){
+        __internal_log_async_push(level, color, label, location, format, args);
+        atomic_fetch_sub_explicit(&log_async_state.producers, 1, memory_order_release);
+        return;
+    }
+
+    atomic_fetch_sub_explicit(&log_async_state.producers, 1, memory_order_relaxed);
+
+    //The whole record is built in a thread-local buffer and leaves with a single write,
+    //so lines coming from different threads can never interleave
+    static __thread char line[LOG_LINE_SIZE];
+
+    size_t header = __internal_log_format_header(line, sizeof(line), color, label, location);
+
+    va_list measure;
+    va_copy(measure, args);
+    int body = vsnprintf(line + header, sizeof(line) - header, format, measure);
+    va_end(measure);
+
+    if(body < 0) return;
+
+    //Keep ordering with anything the caller printed through stdio
+    fflush(stdout);
+
+    if(header + (size_t)body < sizeof(line)){
+        __internal_log_write_all(STDOUT_FILENO, line, header + (size_t)body);
+        return;
+    }
+
+    char* long_line = (char*)malloc(header + (size_t)body + 1);
+    if(long_line == NULL){
+        __internal_log_write_all(STDOUT_FILENO, line, sizeof(line) - 1);
+        return;
+    }
+
+    memcpy(long_line, line, header);
+    vsnprintf(long_line + header, (size_t)body + 1, format, args);
+    __internal_log_write_all(STDOUT_FILENO, long_line, header + (size_t)body);
+    free(long_line);
+}
+
+//Changed at runtime while other threads log, so every access is a relaxed atomic
+static _Atomic int log_runtime_level = LOG_LEVEL_DEBUG;
+
+#define __internal_log_runtime_level() atomic_load_explicit(&log_runtime_level, memory_order_relaxed)
+
+void log_set_level(int level)
+{
+    atomic_store_explicit(&log_runtime_level, level, memory_order_relaxed);
+}
+
+int log_get_level(void)
+{
+    return __internal_log_runtime_level();
+}
+
 void info(const char* format, ...)
 {
+    if(LOG_LEVEL_INFO < __internal_log_runtime_level()) return;
+
     if(format == NULL){
         error("%s: format is NULL!", __func__);
         return;
@@ -145,14 +749,14 @@ void info(const char* format, ...)
 
     va_list args;
     va_start(args, format);
-
-    fprintf(stdout, "%s[INFO]%s ", LOG_COLOR_BLUE, LOG_COLOR_RESET);
-    vfprintf(stdout, format, args);
+    __internal_log_emit(LOG_LEVEL_INFO, LOG_COLOR_BLUE, "INFO", "", format, args);
     va_end(args);
 }
 
 void debug(const char* format, ...)
 {
+    if(LOG_LEVEL_DEBUG < __internal_log_runtime_level()) return;
+
     if(format == NULL){
         error("%s: format is NULL!", __func__);
         return;
@@ -160,14 +764,14 @@ void debug(const char* format, ...)
 
     va_list args;
     va_start(args, format);
-
-    fprintf(stdout, "%s[DEBUG]%s ", LOG_COLOR_BLUE, LOG_COLOR_RESET);
-    vfprintf(stdout, format, args);
+    __internal_log_emit(LOG_LEVEL_DEBUG, LOG_COLOR_BLUE, "DEBUG", "", format, args);
     va_end(args);
 }
 
 void okay(const char* format, ...)
 {
+    if(LOG_LEVEL_SUCCESS < __internal_log_runtime_level()) return;
+
     if(format == NULL){
         error("%s: format is NULL!", __func__);
         return;
@@ -175,14 +779,14 @@ void okay(const char* format, ...)
 
     va_list args;
     va_start(args, format);
-
-    fprintf(stdout, "%s[SUCCESS]%s ", LOG_COLOR_GREEN, LOG_COLOR_RESET);
-    vfprintf(stdout, format, args);
+    __internal_log_emit(LOG_LEVEL_SUCCESS, LOG_COLOR_GREEN, "SUCCESS", "", format, args);
     va_end(args);
 }
 
 void warning(const char* format, ...)
 {
+    if(LOG_LEVEL_WARNING < __internal_log_runtime_level()) return;
+
     if(format == NULL){
         error("%s: format is NULL!", __func__);
         return;
@@ -190,14 +794,14 @@ void warning(const char* format, ...)
 
     va_list args;
     va_start(args, format);
-
-    fprintf(stdout, "%s[WARNING]%s ", LOG_COLOR_YELLOW, LOG_COLOR_RESET);
-    vfprintf(stdout, format, args);
+    __internal_log_emit(LOG_LEVEL_WARNING, LOG_COLOR_YELLOW, "WARNING", "", format, args);
     va_end(args);
 }
 
 void error(const char* format, ...)
 {
+    if(LOG_LEVEL_ERROR < __internal_log_runtime_level()) return;
+
     if(format == NULL){
         fprintf(stdout, "%s[ERROR]%s %s format is NULL!", LOG_COLOR_RED, LOG_COLOR_RESET, __func__);
         return;
@@ -205,9 +809,7 @@ void error(const char* format, ...)
     
     va_list args;
     va_start(args, format);
-
-    fprintf(stdout, "%s[ERROR]%s ", LOG_COLOR_RED, LOG_COLOR_RESET);
-    vfprintf(stdout, format, args);
+    __internal_log_emit(LOG_LEVEL_ERROR, LOG_COLOR_RED, "ERROR", "", format, args);
     va_end(args);
 }
 
@@ -218,12 +820,16 @@ void critical(const char* format, ...)
         return;
     }
     
-    va_list args;
-    va_start(args, format);
+    if(LOG_LEVEL_CRITICAL >= __internal_log_runtime_level()){
+        va_list args;
+        va_start(args, format);
+        __internal_log_emit(LOG_LEVEL_CRITICAL, LOG_COLOR_RED, "CRITICAL", "", format, args);
+        va_end(args);
+    }
 
-    fprintf(stdout, "%s[CRITICAL]%s ", LOG_COLOR_RED, LOG_COLOR_RESET);
-    vfprintf(stdout, format, args);
-    va_end(args);
+    //abort() does not flush, make sure the reason for the crash is written out
+    log_async_flush();
+    fflush(stdout);
     abort();
 }
 
@@ -274,11 +880,654 @@ void log_file(LogType type, const char* file,  const char* format, ...)
     return;
 }
 
+
+void log_at(int level, const char* file, int line, const char* function, const char* format, ...)
+{
+    if(format == NULL){
+        error("%s: format is NULL!", __func__);
+        return;
+    }
+
+    if(level < __internal_log_runtime_level() && level != LOG_LEVEL_CRITICAL) return;
+
+    const char* color = LOG_COLOR_BLUE;
+    const char* label = "DEBUG";
+
+    switch(level){
+        case LOG_LEVEL_DEBUG:    color = LOG_COLOR_BLUE;   label = "DEBUG";    break;
+        case LOG_LEVEL_INFO:     color = LOG_COLOR_BLUE;   label = "INFO";     break;
+        case LOG_LEVEL_SUCCESS:  color = LOG_COLOR_GREEN;  label = "SUCCESS";  break;
+        case LOG_LEVEL_WARNING:  color = LOG_COLOR_YELLOW; label = "WARNING";  break;
+        case LOG_LEVEL_ERROR:    color = LOG_COLOR_RED;    label = "ERROR";    break;
+        case LOG_LEVEL_CRITICAL: color = LOG_COLOR_RED;    label = "CRITICAL"; break;
+        default: break;
+    }
+
+    char location[256];
+    snprintf(location, sizeof(location), "%s:%d %s(): ", file, line, function);
+
+    if(level >= __internal_log_runtime_level()){
+        va_list args;
+        va_start(args, format);
+        __internal_log_emit(level, color, label, location, format, args);
+        va_end(args);
+    }
+
+    if(level == LOG_LEVEL_CRITICAL){
+        log_async_flush();
+        fflush(stdout);
+        abort();
+    }
+}
+
+static unsigned long long __internal_log_now_ms(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned long long)now.tv_sec * 1000ull + (unsigned long long)now.tv_nsec / 1000000ull;
+}
+
+static const char* __internal_log_file_label(LogType type)
+{
+    switch(type){
+        case Success: return "[SUCCESS] ";
+        case Error:   return "[ERROR] ";
+        case Info:    return "[INFO] ";
+        case Warning: return "[WARNING] ";
+        case Custom:  return "";
+        default:
+            __builtin_unreachable();
+    }
+}
+
+static bool __internal_log_sink_reopen(LogSink* sink)
+{
+    sink->fd = open(sink->path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if(sink->fd < 0){
+        error("Could not open: %s for log\n", sink->path);
+        return false;
+    }
+
+    off_t size = lseek(sink->fd, 0, SEEK_END);
+    sink->file_size = size > 0 ? (size_t)size : 0;
+    sink->opened_at_ms = __internal_log_now_ms();
+
+    return true;
+}
+
+static bool __internal_log_sink_flush(LogSink* sink)
+{
+    if(sink->used > 0 && sink->fd >= 0){
+        __internal_log_write_all(sink->fd, sink->buffer, sink->used);
+        sink->file_size += sink->used;
+    }
+
+    sink->used = 0;
+    sink->last_flush_ms = __internal_log_now_ms();
+
+    return sink->fd >= 0;
+}
+
+static bool __internal_log_sink_rotate(LogSink* sink)
+{
+    __internal_log_sink_flush(sink);
+
+    if(sink->fd >= 0){
+        close(sink->fd);
+        sink->fd = -1;
+    }
+
+    time_t now = time(NULL);
+    struct tm local;
+    localtime_r(&now, &local);
+
+    char stamp[32];
+    strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &local);
+
+    size_t rotated_size = strlen(sink->path) + sizeof(stamp) + 32;
+    char* rotated = (char*)malloc(rotated_size);
+    if(rotated == NULL){
+        fprintf(stderr, "[ERROR] Could not allocate memory\n");
+        return __internal_log_sink_reopen(sink);
+    }
+
+    snprintf(rotated, rotated_size, "%s.%s", sink->path, stamp);
+    for(unsigned i = 1; access(rotated, F_OK) == 0; i++){
+        snprintf(rotated, rotated_size, "%s.%s.%u", sink->path, stamp, i);
+    }
+
+    if(rename(sink->path, rotated) < 0){
+        error("Could not rotate log %s: %s\n", sink->path, strerror(errno));
+    }
+
+    free(rotated);
+    return __internal_log_sink_reopen(sink);
+}
+
+static struct timespec __internal_log_deadline_ms(unsigned long long ms)
+{
+    struct timespec deadline = {
+        .tv_sec = (time_t)(ms / 1000ull),
+        .tv_nsec = (long)(ms % 1000ull) * 1000000l,
+    };
+    return deadline;
+}
+
+//Flushes the buffer once records have been waiting for flush_interval_ms, even if no write follows them
+static void* __internal_log_sink_flusher(void* arg)
+{
+    LogSink* sink = (LogSink*)arg;
+
+    pthread_mutex_lock(&sink->lock);
+
+    while(sink->closing == false){
+        unsigned long long now = __internal_log_now_ms();
+        unsigned long long due = sink->last_flush_ms + sink->config.flush_interval_ms;
+
+        if(now >= due){
+            if(sink->used > 0) __internal_log_sink_flush(sink);
+            else sink->last_flush_ms = now;
+            continue;
+        }
+
+        struct timespec deadline = __internal_log_deadline_ms(due);
+        pthread_cond_timedwait(&sink->wake, &sink->lock, &deadline);
+    }
+
+    pthread_mutex_unlock(&sink->lock);
+    return NULL;
+}
+
+bool log_sink_open(LogSink* sink, const char* file, LogSinkConfig config)
+{
+    if(sink == NULL || file == NULL){
+        error("%s: sink or file is NULL!\n", __func__);
+        return false;
+    }
+
+    memset(sink, 0, sizeof(*sink));
+    sink->fd = -1;
+
+    if(config.buffer_size == 0) config.buffer_size = LOG_SINK_DEFAULT_BUFFER_SIZE;
+
+    sink->config = config;
+    sink->capacity = config.buffer_size;
+    sink->path = strdup(file);
+    sink->buffer = (char*)malloc(sink->capacity);
+
+    if(sink->path == NULL || sink->buffer == NULL){
+        fprintf(stderr, "[ERROR] Could not allocate memory\n");
+        free(sink->path);
+        free(sink->buffer);
+        return false;
+    }
+
+    if(__internal_log_sink_reopen(sink) == false){
+        free(sink->path);
+        free(sink->buffer);
+        return false;
+    }
+
+    sink->last_flush_ms = sink->opened_at_ms;
+    pthread_mutex_init(&sink->lock, NULL);
+
+    //The flusher deadlines come from CLOCK_MONOTONIC like every other sink timestamp
+    pthread_condattr_t attributes;
+    pthread_condattr_init(&attributes);
+    pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+    pthread_cond_init(&sink->wake, &attributes);
+    pthread_condattr_destroy(&attributes);
+
+    if(config.flush_interval_ms > 0){
+        if(pthread_create(&sink->flusher, NULL, __internal_log_sink_flusher, sink) == 0){
+            sink->flusher_running = true;
+        }
+        else{
+            error("Could not start the flush thread for %s, records are flushed on the next write\n", file);
+        }
+    }
+
+    return true;
+}
+
+void log_sink_write(LogSink* sink, LogType type, const char* format, ...)
+{
+    if(sink == NULL || format == NULL){
+        error("%s: sink or format is NULL!\n", __func__);
+        return;
+    }
+
+    pthread_mutex_lock(&sink->lock);
+
+    unsigned long long now = __internal_log_now_ms();
+
+    if(sink->config.rotate_interval_s > 0 &&
+       now - sink->opened_at_ms >= (unsigned long long)sink->config.rotate_interval_s * 1000ull){
+        __internal_log_sink_rotate(sink);
+    }
+
+    const char* label = __internal_log_file_label(type);
+
+    va_list args;
+    va_start(args, format);
+
+    va_list measure;
+    va_copy(measure, args);
+    int body = vsnprintf(NULL, 0, format, measure);
+    va_end(measure);
+
+    size_t record = strlen(label) + (body > 0 ? (size_t)body : 0);
+
+    if(sink->config.rotate_size > 0 && sink->file_size + sink->used + record > sink->config.rotate_size &&
+       sink->file_size + sink->used > 0){
+        __internal_log_sink_rotate(sink);
+    }
+
+    if(sink->used + record + 1 > sink->capacity){
+        __internal_log_sink_flush(sink);
+    }
+
+    if(record + 1 <= sink->capacity){
+        int prefix = snprintf(sink->buffer + sink->used, sink->capacity - sink->used, "%s", label);
+        vsnprintf(sink->buffer + sink->used + prefix, sink->capacity - sink->used - prefix, format, args);
+        sink->used += record;
+    }
+    else{
+        //Record larger than the whole buffer, it goes out on its own
+        char* oversized = (char*)malloc(record + 1);
+        if(oversized != NULL){
+            int prefix = snprintf(oversized, record + 1, "%s", label);
+            vsnprintf(oversized + prefix, record + 1 - prefix, format, args);
+            __internal_log_write_all(sink->fd, oversized, record);
+            sink->file_size += record;
+            free(oversized);
+        }
+    }
+
+    va_end(args);
+
+    bool flush_now = (sink->config.flush_on & LOG_SINK_FLUSH_ON(type)) != 0;
+    if(sink->config.flush_interval_ms > 0 && now - sink->last_flush_ms >= sink->config.flush_interval_ms){
+        flush_now = true;
+    }
+
+    if(flush_now) __internal_log_sink_flush(sink);
+
+    pthread_mutex_unlock(&sink->lock);
+}
+
+bool log_sink_flush(LogSink* sink)
+{
+    if(sink == NULL) return false;
+
+    pthread_mutex_lock(&sink->lock);
+    bool flushed = __internal_log_sink_flush(sink);
+    pthread_mutex_unlock(&sink->lock);
+
+    return flushed;
+}
+
+bool log_sink_rotate(LogSink* sink)
+{
+    if(sink == NULL) return false;
+
+    pthread_mutex_lock(&sink->lock);
+    bool rotated = __internal_log_sink_rotate(sink);
+    pthread_mutex_unlock(&sink->lock);
+
+    return rotated;
+}
+
+void log_sink_close(LogSink* sink)
+{
+    if(sink == NULL || sink->buffer == NULL) return;
+
+    pthread_mutex_lock(&sink->lock);
+    sink->closing = true;
+    pthread_cond_signal(&sink->wake);
+    pthread_mutex_unlock(&sink->lock);
+
+    if(sink->flusher_running) pthread_join(sink->flusher, NULL);
+
+    pthread_mutex_lock(&sink->lock);
+    __internal_log_sink_flush(sink);
+    if(sink->fd >= 0) close(sink->fd);
+    pthread_mutex_unlock(&sink->lock);
+
+    pthread_cond_destroy(&sink->wake);
+    pthread_mutex_destroy(&sink->lock);
+    free(sink->buffer);
+    free(sink->path);
+    memset(sink, 0, sizeof(*sink));
+    sink->fd = -1;
+}
+
+//Finds the next conversion in format. Returns the position after it, or NULL when there are none left.
+//stars is the number of '*' width/precision arguments (passed as int) that precede the value itself.
+const char* log_binary_next_spec(const char* format, const char** spec, size_t* spec_size, LogBinaryArg* arg, int* stars)
+{
+    for(const char* cursor = format; *cursor != '\0'; cursor++){
+        if(*cursor != '%') continue;
+
+        const char* start = cursor++;
+        if(*cursor == '%') continue;
+
+        *stars = 0;
+        while(*cursor != '\0' && strchr("-+ #0'", *cursor) != NULL) cursor++;
+        if(*cursor == '*'){ (*stars)++; cursor++; }
+        while(*cursor >= '0' && *cursor <= '9') cursor++;
+        if(*cursor == '.'){
+            cursor++;
+            if(*cursor == '*'){ (*stars)++; cursor++; }
+            while(*cursor >= '0' && *cursor <= '9') cursor++;
+        }
+
+        LogBinaryArg integer = LogBinaryArgInt;
+        switch(*cursor){
+            case 'h': cursor++; if(*cursor == 'h') cursor++; break;
+            case 'l':
+                cursor++;
+                integer = LogBinaryArgLong;
+                if(*cursor == 'l'){ cursor++; integer = LogBinaryArgLongLong; }
+                break;
+            case 'z': cursor++; integer = LogBinaryArgSize;    break;
+            case 'j': cursor++; integer = LogBinaryArgIntMax;  break;
+            case 't': cursor++; integer = LogBinaryArgPtrDiff; break;
+            case 'L': return NULL;
+            default: break;
+        }
+
+        switch(*cursor){
+            case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': case 'c':
+                if(*cursor == 'c' && integer != LogBinaryArgInt) return NULL;
+                *arg = integer;
+                break;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+                *arg = LogBinaryArgDouble;
+                break;
+            case 's':
+                if(integer != LogBinaryArgInt) return NULL;
+                *arg = LogBinaryArgString;
+                break;
+            case 'p':
+                *arg = LogBinaryArgPointer;
+                break;
+            default:
+                //%n, wide and unknown conversions cannot be replayed offline
+                return NULL;
+        }
+
+        *spec = start;
+        *spec_size = (size_t)(cursor - start) + 1;
+        return cursor + 1;
+    }
+
+    return NULL;
+}
+
+static bool __internal_log_binary_flush(LogBinary* log)
+{
+    if(log->used > 0){
+        __internal_log_write_all(log->fd, log->buffer, log->used);
+        log->used = 0;
+    }
+    return true;
+}
+
+static void __internal_log_binary_append(LogBinary* log, const void* data, size_t size)
+{
+    if(log->used + size > log->capacity){
+        __internal_log_binary_flush(log);
+        if(size > log->capacity){
+            __internal_log_write_all(log->fd, (const char*)data, size);
+            return;
+        }
+    }
+
+    memcpy(log->buffer + log->used, data, size);
+    log->used += size;
+}
+
+bool log_binary_open(LogBinary* log, const char* file, size_t buffer_size)
+{
+    if(log == NULL || file == NULL){
+        error("%s: log or file is NULL!\n", __func__);
+        return false;
+    }
+
+    memset(log, 0, sizeof(*log));
+
+    if(buffer_size == 0) buffer_size = LOG_BINARY_DEFAULT_BUFFER_SIZE;
+
+    log->buffer = (char*)malloc(buffer_size);
+    log->formats = (LogBinaryFormat*)calloc(LOG_BINARY_MAX_FORMATS, sizeof(LogBinaryFormat));
+    if(log->buffer == NULL || log->formats == NULL){
+        fprintf(stderr, "[ERROR] Could not allocate memory\n");
+        free(log->buffer);
+        free(log->formats);
+        return false;
+    }
+
+    log->fd = open(file, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if(log->fd < 0){
+        error("Could not open: %s for log\n", file);
+        free(log->buffer);
+        free(log->formats);
+        return false;
+    }
+
+    log->capacity = buffer_size;
+    pthread_mutex_init(&log->lock, NULL);
+
+    uint16_t version = LOG_BINARY_VERSION;
+    __internal_log_binary_append(log, LOG_BINARY_MAGIC, 4);
+    __internal_log_binary_append(log, &version, sizeof(version));
+
+    return true;
+}
+
+int log_binary_register(LogBinary* log, const char* format)
+{
+    if(log == NULL || format == NULL){
+        error("%s: log or format is NULL!\n", __func__);
+        return -1;
+    }
+
+    LogBinaryFormat parsed = {0};
+    const char* cursor = format;
+    const char* spec;
+    size_t spec_size;
+    LogBinaryArg arg;
+    int stars;
+
+    for(;;){
+        const char* percent = strchr(cursor, '%');
+        while(percent != NULL && percent[1] == '%') percent = strchr(percent + 2, '%');
+        if(percent == NULL) break;
+
+        const char* next = log_binary_next_spec(cursor, &spec, &spec_size, &arg, &stars);
+        if(next == NULL || parsed.count + stars + 1 > LOG_BINARY_MAX_ARGS){
+            error("%s: unsupported format \"%s\"\n", __func__, format);
+            return -1;
+        }
+
+        for(int i = 0; i < stars; i++) parsed.args[parsed.count++] = LogBinaryArgInt;
+        parsed.args[parsed.count++] = (uint8_t)arg;
+        cursor = next;
+    }
+
+    size_t format_size = strlen(format);
+    if(format_size > UINT16_MAX){
+        error("%s: format is too long\n", __func__);
+        return -1;
+    }
+
+    pthread_mutex_lock(&log->lock);
+
+    uint16_t id = __atomic_load_n(&log->format_count, __ATOMIC_RELAXED);
+    if(id == LOG_BINARY_MAX_FORMATS){
+        pthread_mutex_unlock(&log->lock);
+        error("%s: too many formats registered\n", __func__);
+        return -1;
+    }
+
+    log->formats[id] = parsed;
+
+    uint8_t kind = LOG_BINARY_KIND_FORMAT;
+    uint16_t size = (uint16_t)format_size;
+    __internal_log_binary_append(log, &kind, sizeof(kind));
+    __internal_log_binary_append(log, &id, sizeof(id));
+    __internal_log_binary_append(log, &size, sizeof(size));
+    __internal_log_binary_append(log, format, format_size);
+
+    __atomic_store_n(&log->format_count, (uint16_t)(id + 1), __ATOMIC_RELEASE);
+
+    pthread_mutex_unlock(&log->lock);
+
+    return id;
+}
+
+void log_binary_write(LogBinary* log, LogType type, int format_id, ...)
+{
+    if(log == NULL || format_id < 0 || format_id >= (int)__atomic_load_n(&log->format_count, __ATOMIC_ACQUIRE)) return;
+
+    uint32_t thread_id = __internal_log_thread_id();
+
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+
+    //kind, id, level, thread, timestamp, payload size
+    uint8_t record[1 + 2 + 1 + 4 + 8 + 4 + LOG_BINARY_MAX_ARGS * 8];
+    size_t size = 0;
+
+    const LogBinaryFormat* format = &log->formats[format_id];
+    uint16_t id = (uint16_t)format_id;
+    uint64_t timestamp = (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+    uint32_t payload = 0;
+
+    record[size++] = LOG_BINARY_KIND_RECORD;
+    memcpy(record + size, &id, 2);                    size += 2;
+    record[size++] = (uint8_t)type;
+    memcpy(record + size, &thread_id, 4);             size += 4;
+    memcpy(record + size, &timestamp, 8);             size += 8;
+    size_t payload_at = size;                         size += 4;
+
+    //Strings are copied straight into the log buffer after the fixed size arguments
+    const char* strings[LOG_BINARY_MAX_ARGS];
+    uint16_t string_sizes[LOG_BINARY_MAX_ARGS];
+    uint8_t string_count = 0;
+
+    va_list args;
+    va_start(args, format_id);
+
+    for(uint8_t i = 0; i < format->count; i++){
+        int32_t small;
+        int64_t wide = 0;
+        double real;
+        uint64_t pointer;
+
+        switch((LogBinaryArg)format->args[i]){
+            case LogBinaryArgInt:
+                small = va_arg(args, int);
+                memcpy(record + size, &small, 4); size += 4;
+                break;
+            case LogBinaryArgLong:
+            case LogBinaryArgLongLong:
+            case LogBinaryArgSize:
+            case LogBinaryArgIntMax:
+            case LogBinaryArgPtrDiff:
+                switch((LogBinaryArg)format->args[i]){
+                    case LogBinaryArgLong:     wide = (int64_t)va_arg(args, long);      break;
+                    case LogBinaryArgLongLong: wide = (int64_t)va_arg(args, long long); break;
+                    case LogBinaryArgSize:     wide = (int64_t)va_arg(args, size_t);    break;
+                    case LogBinaryArgIntMax:   wide = (int64_t)va_arg(args, intmax_t);  break;
+                    default:                   wide = (int64_t)va_arg(args, ptrdiff_t); break;
+                }
+                memcpy(record + size, &wide, 8); size += 8;
+                break;
+            case LogBinaryArgDouble:
+                real = va_arg(args, double);
+                memcpy(record + size, &real, 8); size += 8;
+                break;
+            case LogBinaryArgPointer:
+                pointer = (uint64_t)(uintptr_t)va_arg(args, void*);
+                memcpy(record + size, &pointer, 8); size += 8;
+                break;
+            case LogBinaryArgString: {
+                const char* string = va_arg(args, const char*);
+                if(string == NULL) string = "(null)";
+                size_t length = strnlen(string, LOG_BINARY_MAX_STRING);
+                strings[string_count] = string;
+                string_sizes[string_count] = (uint16_t)length;
+                string_count++;
+                memcpy(record + size, &string_sizes[string_count - 1], 2); size += 2;
+                payload += (uint32_t)length;
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    va_end(args);
+
+    payload += (uint32_t)(size - payload_at - 4);
+    memcpy(record + payload_at, &payload, 4);
+
+    pthread_mutex_lock(&log->lock);
+    __internal_log_binary_append(log, record, size);
+    for(uint8_t i = 0; i < string_count; i++){
+        __internal_log_binary_append(log, strings[i], string_sizes[i]);
+    }
+    pthread_mutex_unlock(&log->lock);
+}
+
+bool log_binary_flush(LogBinary* log)
+{
+    if(log == NULL) return false;
+
+    pthread_mutex_lock(&log->lock);
+    bool flushed = __internal_log_binary_flush(log);
+    pthread_mutex_unlock(&log->lock);
+
+    return flushed;
+}
+
+void log_binary_close(LogBinary* log)
+{
+    if(log == NULL || log->buffer == NULL) return;
+
+    log_binary_flush(log);
+    close(log->fd);
+
+    pthread_mutex_destroy(&log->lock);
+    free(log->buffer);
+    free(log->formats);
+    memset(log, 0, sizeof(*log));
+    log->fd = -1;
+}
 #endif
 
 #ifdef WINDOWS
+//Aligned LONG reads are atomic on Windows, older MSVC C has no <stdatomic.h>
+static volatile LONG log_runtime_level = LOG_LEVEL_DEBUG;
+
+#define __internal_log_runtime_level() ((int)log_runtime_level)
+
+void log_set_level(int level)
+{
+    InterlockedExchange(&log_runtime_level, (LONG)level);
+}
+
+int log_get_level(void)
+{
+    return __internal_log_runtime_level();
+}
+
 void info(CONST WCHAR* format, ...)
 {
+    if(LOG_LEVEL_INFO < __internal_log_runtime_level()) return;
+
     if(format == NULL){
         error(L"%s: format is NULL!", __func__);
         return;
@@ -299,6 +1548,8 @@ void info(CONST WCHAR* format, ...)
 
 void debug(CONST WCHAR* format, ...)
 {
+    if(LOG_LEVEL_DEBUG < __internal_log_runtime_level()) return;
+
     if(format == NULL){
         error(L"%s: format is NULL!", __func__);
         return;
@@ -319,6 +1570,8 @@ void debug(CONST WCHAR* format, ...)
 
 void okay(CONST WCHAR* format, ...)
 {
+    if(LOG_LEVEL_SUCCESS < __internal_log_runtime_level()) return;
+
     if(format == NULL){
         error(L"%s: format is NULL!", __func__);
         return;
@@ -339,6 +1592,8 @@ void okay(CONST WCHAR* format, ...)
 
 void warning(CONST WCHAR* format, ...)
 {
+    if(LOG_LEVEL_WARNING < __internal_log_runtime_level()) return;
+
     if(format == NULL){
         error(L"%s: format is NULL!", __func__);
         return;
@@ -359,6 +1614,8 @@ void warning(CONST WCHAR* format, ...)
 
 void error(CONST WCHAR* format, ...)
 {
+    if(LOG_LEVEL_ERROR < __internal_log_runtime_level()) return;
+
     if(format == NULL){
         error(L"%s: format is NULL!", __func__);
         return;
@@ -384,17 +1641,22 @@ void critical(CONST WCHAR* format, ...)
         return;
     }
 
-    va_list args;
-    va_start(args, format);
-    HANDLE hConsole;
-    hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
+    if(LOG_LEVEL_CRITICAL >= __internal_log_runtime_level()){
+        va_list args;
+        va_start(args, format);
+        HANDLE hConsole;
+        hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
 
-    SetConsoleTextAttribute(hConsole, LOG_COLOR_RED);
-    fwprintf(stdout, L"[CRITICAL] ");
-    SetConsoleTextAttribute(hConsole, LOG_COLOR_RESET);
-    vfwprintf(stdout, format, args);
-    
-    va_end(args);
+        SetConsoleTextAttribute(hConsole, LOG_COLOR_RED);
+        fwprintf(stdout, L"[CRITICAL] ");
+        SetConsoleTextAttribute(hConsole, LOG_COLOR_RESET);
+        vfwprintf(stdout, format, args);
+
+        va_end(args);
+    }
+
+    //abort() does not flush, make sure the reason for the crash is written out
+    fflush(stdout);
     abort();
 }
 
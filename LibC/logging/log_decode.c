@@ -0,0 +1,334 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+//Offline decoder for the binary log written by log_binary_open/log_binary_write.
+//Usage: log_decode <binary log> [output]
+
+#ifdef __linux__
+    //clock_gettime, localtime_r, syscall and O_CLOEXEC under -std=c11
+    #define _GNU_SOURCE
+#endif
+
+#define LIB_LOG_IMPLEMENTATION
+#include "log.h"
+
+#include <inttypes.h>
+
+typedef struct
+{
+    char* text;
+    LogBinaryFormat parsed;
+}DecodeFormat;
+
+static const char* decode_label(uint8_t type)
+{
+    switch(type){
+        case Success: return "[SUCCESS] ";
+        case Error:   return "[ERROR] ";
+        case Info:    return "[INFO] ";
+        case Warning: return "[WARNING] ";
+        default:      return "";
+    }
+}
+
+static bool decode_read(FILE* input, void* data, size_t size)
+{
+    return size == 0 || fread(data, size, 1, input) == 1;
+}
+
+//Rewrites an integer conversion so that it takes a long long, whatever length modifier it had
+static void decode_wide_spec(const char* spec, size_t spec_size, char* out, size_t out_size)
+{
+    size_t used = 0;
+    char conversion = spec[spec_size - 1];
+
+    for(size_t i = 0; i < spec_size - 1 && used + 4 < out_size; i++){
+        if(strchr("hlzjt", spec[i]) != NULL) continue;
+        out[used++] = spec[i];
+    }
+
+    out[used++] = 'l';
+    out[used++] = 'l';
+    out[used++] = conversion;
+    out[used] = '\0';
+}
+
+//Widths and precisions written in the format itself are bounded like the '*' ones
+static bool decode_spec_bounded(const char* spec, size_t spec_size)
+{
+    long number = 0;
+    for(size_t i = 0; i < spec_size; i++){
+        if(spec[i] < '0' || spec[i] > '9'){
+            number = 0;
+            continue;
+        }
+
+        number = number * 10 + (spec[i] - '0');
+        if(number > LOG_BINARY_MAX_STRING) return false;
+    }
+
+    return true;
+}
+
+static void decode_record(FILE* output, const DecodeFormat* format, const uint8_t* payload, uint32_t payload_size)
+{
+    //Fixed size arguments come first, string bytes follow in argument order
+    size_t fixed = 0;
+    for(uint8_t i = 0; i < format->parsed.count; i++){
+        switch((LogBinaryArg)format->parsed.args[i]){
+            case LogBinaryArgInt:    fixed += 4; break;
+            case LogBinaryArgString: fixed += 2; break;
+            default:                 fixed += 8; break;
+        }
+    }
+
+    if(fixed > payload_size){
+        fprintf(output, "<corrupted record>\n");
+        return;
+    }
+
+    const uint8_t* values = payload;
+    const char* strings = (const char*)payload + fixed;
+    const char* strings_end = (const char*)payload + payload_size;
+
+    const char* cursor = format->text;
+    uint8_t arg_index = 0;
+
+    for(;;){
+        const char* spec;
+        size_t spec_size;
+        LogBinaryArg arg;
+        int stars;
+        const char* next = log_binary_next_spec(cursor, &spec, &spec_size, &arg, &stars);
+
+        const char* literal_end = next != NULL ? spec : cursor + strlen(cursor);
+        for(const char* c = cursor; c < literal_end; c++){
+            fputc(*c, output);
+            if(c[0] == '%' && c + 1 < literal_end && c[1] == '%') c++;
+        }
+
+        if(next == NULL) break;
+
+        int star_values[2] = {0, 0};
+        for(int i = 0; i < stars; i++){
+            int32_t value;
+            memcpy(&value, values, 4);
+            values += 4;
+            //Widths come from the file, keep a corrupt one from padding out gigabytes
+            if(value > LOG_BINARY_MAX_STRING) value = LOG_BINARY_MAX_STRING;
+            if(value < -LOG_BINARY_MAX_STRING) value = -LOG_BINARY_MAX_STRING;
+            star_values[i] = value;
+            arg_index++;
+        }
+
+        char piece[64];
+        size_t copy = spec_size < sizeof(piece) ? spec_size : sizeof(piece) - 1;
+        memcpy(piece, spec, copy);
+        piece[copy] = '\0';
+
+        char wide_piece[72];
+        int32_t small;
+        int64_t wide;
+        double real;
+        uint64_t pointer;
+        uint16_t length;
+
+        //Every case forwards the collected '*' values ahead of the argument
+        #define DECODE_PRINT(fmt, value) do { \
+                if(stars == 2)      fprintf(output, fmt, star_values[0], star_values[1], value); \
+                else if(stars == 1) fprintf(output, fmt, star_values[0], value); \
+                else                fprintf(output, fmt, value); \
+            } while(0)
+
+        switch(arg){
+            case LogBinaryArgInt:
+                memcpy(&small, values, 4); values += 4;
+                DECODE_PRINT(piece, (int)small);
+                break;
+            case LogBinaryArgDouble:
+                memcpy(&real, values, 8); values += 8;
+                DECODE_PRINT(piece, real);
+                break;
+            case LogBinaryArgPointer:
+                memcpy(&pointer, values, 8); values += 8;
+                DECODE_PRINT(piece, (void*)(uintptr_t)pointer);
+                break;
+            case LogBinaryArgString: {
+                memcpy(&length, values, 2); values += 2;
+                if(strings + length > strings_end) length = (uint16_t)(strings_end - strings);
+                char* string = (char*)malloc((size_t)length + 1);
+                if(string != NULL){
+                    memcpy(string, strings, length);
+                    string[length] = '\0';
+                    DECODE_PRINT(piece, string);
+                    free(string);
+                }
+                strings += length;
+                break;
+            }
+            default:
+                memcpy(&wide, values, 8); values += 8;
+                decode_wide_spec(piece, strlen(piece), wide_piece, sizeof(wide_piece));
+                DECODE_PRINT(wide_piece, (long long)wide);
+                break;
+        }
+
+        #undef DECODE_PRINT
+
+        arg_index++;
+        cursor = next;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if(argc < 2){
+        fprintf(stderr, "Usage: %s <binary log> [output]\n", argv[0]);
+        return 1;
+    }
+
+    FILE* input = fopen(argv[1], "rb");
+    if(input == NULL){
+        fprintf(stderr, "[ERROR] Could not open: %s\n", strerror(errno));
+        return 1;
+    }
+
+    FILE* output = stdout;
+    if(argc > 2){
+        output = fopen(argv[2], "w");
+        if(output == NULL){
+            fprintf(stderr, "[ERROR] Could not open: %s\n", strerror(errno));
+            fclose(input);
+            return 1;
+        }
+    }
+
+    char magic[4];
+    uint16_t version;
+    if(decode_read(input, magic, 4) == false || memcmp(magic, LOG_BINARY_MAGIC, 4) != 0 ||
+       decode_read(input, &version, 2) == false || version != LOG_BINARY_VERSION){
+        fprintf(stderr, "[ERROR] %s is not a binary log\n", argv[1]);
+        fclose(input);
+        return 1;
+    }
+
+    DecodeFormat* formats = (DecodeFormat*)calloc(LOG_BINARY_MAX_FORMATS, sizeof(DecodeFormat));
+    uint8_t* payload = (uint8_t*)malloc(UINT16_MAX + LOG_BINARY_MAX_ARGS * (8 + LOG_BINARY_MAX_STRING));
+    if(formats == NULL || payload == NULL){
+        fprintf(stderr, "[ERROR] Could not allocate memory\n");
+        free(formats);
+        free(payload);
+        fclose(input);
+        if(output != stdout) fclose(output);
+        return 1;
+    }
+
+    int status = 0;
+    uint8_t kind;
+
+    while(decode_read(input, &kind, 1)){
+        uint16_t id;
+        if(decode_read(input, &id, 2) == false) break;
+
+        //Ids come from the file, a corrupt log must not index past the format table
+        if(id >= LOG_BINARY_MAX_FORMATS){
+            fprintf(stderr, "[ERROR] Format id %u is out of range\n", id);
+            status = 1;
+            break;
+        }
+
+        if(kind == LOG_BINARY_KIND_FORMAT){
+            uint16_t size;
+            if(decode_read(input, &size, 2) == false) break;
+
+            free(formats[id].text);
+            formats[id].text = (char*)calloc((size_t)size + 1, 1);
+            if(formats[id].text == NULL || decode_read(input, formats[id].text, size) == false) break;
+
+            memset(&formats[id].parsed, 0, sizeof(formats[id].parsed));
+            const char* cursor = formats[id].text;
+            const char* spec;
+            size_t spec_size;
+            LogBinaryArg arg;
+            int stars;
+            while((cursor = log_binary_next_spec(cursor, &spec, &spec_size, &arg, &stars)) != NULL){
+                if(formats[id].parsed.count + (size_t)stars + 1 > LOG_BINARY_MAX_ARGS) break;
+                if(decode_spec_bounded(spec, spec_size) == false) break;
+                for(int i = 0; i < stars; i++) formats[id].parsed.args[formats[id].parsed.count++] = LogBinaryArgInt;
+                formats[id].parsed.args[formats[id].parsed.count++] = (uint8_t)arg;
+            }
+
+            if(cursor != NULL){
+                fprintf(stderr, "[ERROR] Format %u has more than %d arguments or an oversized width\n", id, LOG_BINARY_MAX_ARGS);
+                status = 1;
+                break;
+            }
+            continue;
+        }
+
+        if(kind != LOG_BINARY_KIND_RECORD){
+            fprintf(stderr, "[ERROR] Unknown record kind 0x%02X\n", kind);
+            status = 1;
+            break;
+        }
+
+        uint8_t type;
+        uint32_t thread;
+        uint64_t timestamp;
+        uint32_t payload_size;
+        if(decode_read(input, &type, 1) == false || decode_read(input, &thread, 4) == false ||
+           decode_read(input, &timestamp, 8) == false || decode_read(input, &payload_size, 4) == false){
+            break;
+        }
+
+        if(payload_size > UINT16_MAX + LOG_BINARY_MAX_ARGS * (8 + LOG_BINARY_MAX_STRING) ||
+           decode_read(input, payload, payload_size) == false){
+            fprintf(stderr, "[ERROR] Truncated record\n");
+            status = 1;
+            break;
+        }
+
+        if(formats[id].text == NULL){
+            fprintf(stderr, "[ERROR] Record references unknown format %u\n", id);
+            continue;
+        }
+
+        time_t seconds = (time_t)(timestamp / 1000000000ull);
+        struct tm local;
+        localtime_r(&seconds, &local);
+        char stamp[32];
+        strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", &local);
+
+        fprintf(output, "%s%s.%09" PRIu64 " [%" PRIu32 "] ", decode_label(type), stamp, (uint64_t)(timestamp % 1000000000ull), thread);
+        decode_record(output, &formats[id], payload, payload_size);
+    }
+
+    for(size_t i = 0; i < LOG_BINARY_MAX_FORMATS; i++) free(formats[i].text);
+    free(formats);
+    free(payload);
+    fclose(input);
+    if(output != stdout) fclose(output);
+
+    return status;
+}
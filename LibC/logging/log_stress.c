@@ -0,0 +1,243 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Andrea Michael M. Molino
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+//Stress test for concurrent logging: many threads call info() at once, stdout goes to a file,
+//then every line is checked to hold exactly one whole record and throughput is reported.
+//Build: cc -O2 -std=c11 log_stress.c -lpthread -o log_stress
+//Usage: log_stress [threads] [lines per thread]
+
+#ifdef __linux__
+    //clock_gettime, localtime_r, syscall and O_CLOEXEC under -std=c11
+    #define _GNU_SOURCE
+#endif
+
+#define LIB_LOG_IMPLEMENTATION
+#include "log.h"
+
+#define STRESS_OUTPUT "log_stress.tmp"
+#define STRESS_MAX_PAYLOAD 300
+//Every so often a sync run logs a line past LOG_LINE_SIZE to cover the heap path
+#define STRESS_LONG_EVERY 997
+#define STRESS_LONG_PAYLOAD (LOG_LINE_SIZE + 1000)
+
+typedef struct
+{
+    int id;
+    size_t lines;
+    bool long_lines;
+    char* payload;
+}StressThread;
+
+static unsigned long long stress_now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned long long)now.tv_sec * 1000000000ULL + (unsigned long long)now.tv_nsec;
+}
+
+static size_t stress_payload_size(int id, size_t sequence, bool long_lines)
+{
+    if(long_lines && sequence % STRESS_LONG_EVERY == (size_t)id) return STRESS_LONG_PAYLOAD;
+    return (sequence * 31 + (size_t)id * 7) % STRESS_MAX_PAYLOAD;
+}
+
+static void* stress_thread(void* arg)
+{
+    StressThread* thread = (StressThread*)arg;
+
+    for(size_t sequence = 0; sequence < thread->lines; sequence++){
+        int size = (int)stress_payload_size(thread->id, sequence, thread->long_lines);
+        info("t=%d s=%zu n=%d |%.*s|\n", thread->id, sequence, size, size, thread->payload);
+    }
+
+    return NULL;
+}
+
+//Returns the number of torn or malformed lines, next_sequence tracks the per-thread order
+static size_t stress_check(const char* data, size_t size, size_t* next_sequence, int threads, size_t* lines)
+{
+    static const char header[] = LOG_COLOR_BLUE "[INFO]" LOG_COLOR_RESET " ";
+    size_t torn = 0;
+    const char* end = data + size;
+
+    while(data < end){
+        const char* newline = (const char*)memchr(data, '\n', (size_t)(end - data));
+        if(newline == NULL) newline = end;
+        (*lines)++;
+
+        bool valid = false;
+        const char* body = (const char*)memmem(data, (size_t)(newline - data), "t=", 2);
+        int id = -1;
+        size_t sequence = 0;
+        int payload_size = -1;
+        int consumed = 0;
+
+        //sscanf measures its whole input first, so it only ever sees a copy of the fields
+        char fields[64] = "";
+        if(body != NULL){
+            size_t length = (size_t)(newline - body) < sizeof(fields) - 1 ? (size_t)(newline - body) : sizeof(fields) - 1;
+            memcpy(fields, body, length);
+            fields[length] = '\0';
+        }
+
+        if((size_t)(newline - data) > sizeof(header) - 1 && memcmp(data, header, sizeof(header) - 1) == 0 &&
+           body != NULL &&
+           sscanf(fields, "t=%d s=%zu n=%d |%n", &id, &sequence, &payload_size, &consumed) == 3 && consumed > 0 &&
+           id >= 0 && id < threads && payload_size >= 0){
+            const char* payload = body + consumed;
+            valid = newline - payload == payload_size + 1 && payload[payload_size] == '|';
+            for(int i = 0; valid && i < payload_size; i++){
+                valid = payload[i] == (char)('a' + id % 26);
+            }
+            if(valid){
+                valid = sequence == next_sequence[id];
+                next_sequence[id]++;
+            }
+        }
+
+        if(valid == false) torn++;
+        data = newline + 1;
+    }
+
+    return torn;
+}
+
+static bool stress_run(const char* name, int threads, size_t lines_per_thread, bool async, bool long_lines)
+{
+    fflush(stdout);
+    int saved_stdout = dup(STDOUT_FILENO);
+    int output = open(STRESS_OUTPUT, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if(saved_stdout < 0 || output < 0 || dup2(output, STDOUT_FILENO) < 0){
+        fprintf(stderr, "[ERROR] Could not redirect stdout to %s: %s\n", STRESS_OUTPUT, strerror(errno));
+        return false;
+    }
+    close(output);
+
+    StressThread* workers = (StressThread*)calloc((size_t)threads, sizeof(StressThread));
+    pthread_t* handles = (pthread_t*)calloc((size_t)threads, sizeof(pthread_t));
+    bool started = workers != NULL && handles != NULL;
+
+    if(started && async) started = log_async_start(LOG_ASYNC_DEFAULT_CAPACITY, LogAsyncBlock);
+
+    unsigned long long start = stress_now_ns();
+    int running = 0;
+    for(; started && running < threads; running++){
+        StressThread* worker = &workers[running];
+        worker->id = running;
+        worker->lines = lines_per_thread;
+        worker->long_lines = long_lines;
+        worker->payload = (char*)malloc(STRESS_LONG_PAYLOAD);
+        if(worker->payload == NULL) break;
+        memset(worker->payload, 'a' + running % 26, STRESS_LONG_PAYLOAD);
+
+        if(pthread_create(&handles[running], NULL, stress_thread, worker) != 0){
+            free(worker->payload);
+            break;
+        }
+    }
+
+    for(int i = 0; i < running; i++) pthread_join(handles[i], NULL);
+    if(started && async) log_async_stop();
+    unsigned long long elapsed = stress_now_ns() - start;
+
+    dup2(saved_stdout, STDOUT_FILENO);
+    close(saved_stdout);
+
+    if(running < threads){
+        fprintf(stderr, "[ERROR] Could not start %d threads\n", threads);
+        started = false;
+    }
+
+    size_t* next_sequence = (size_t*)calloc((size_t)threads, sizeof(size_t));
+    FILE* input = fopen(STRESS_OUTPUT, "rb");
+    char* data = NULL;
+    long size = 0;
+    if(input != NULL && fseek(input, 0, SEEK_END) == 0 && (size = ftell(input)) >= 0 && fseek(input, 0, SEEK_SET) == 0){
+        data = (char*)malloc((size_t)size + 1);
+        if(data != NULL && fread(data, 1, (size_t)size, input) == (size_t)size) data[size] = '\0';
+        else{
+            free(data);
+            data = NULL;
+        }
+    }
+    if(input != NULL) fclose(input);
+
+    bool passed = false;
+    if(started && data != NULL && next_sequence != NULL){
+        size_t lines = 0;
+        size_t torn = stress_check(data, (size_t)size, next_sequence, threads, &lines);
+
+        size_t missing = 0;
+        for(int i = 0; i < threads; i++) missing += lines_per_thread - next_sequence[i];
+
+        double seconds = (double)elapsed / 1e9;
+        printf("%-36s %10.0f lines/s %8.1f MB/s  lines %zu torn %zu missing %zu\n",
+               name, (double)lines / seconds, (double)size / (1024.0 * 1024.0) / seconds, lines, torn, missing);
+        passed = torn == 0 && missing == 0 && lines == (size_t)threads * lines_per_thread;
+    }
+
+    for(int i = 0; i < running; i++) free(workers[i].payload);
+    free(workers);
+    free(handles);
+    free(next_sequence);
+    free(data);
+    remove(STRESS_OUTPUT);
+
+    return passed;
+}
+
+int main(int argc, char** argv)
+{
+    int threads = argc > 1 ? atoi(argv[1]) : 16;
+    size_t lines = argc > 2 ? strtoul(argv[2], NULL, 10) : 50000;
+
+    if(threads < 1){
+        error("%s: thread count must be at least 1\n", argv[0]);
+        return 1;
+    }
+
+    printf("%d threads x %zu lines\n", threads, lines);
+
+    bool passed = true;
+    passed &= stress_run("sync", threads, lines, false, true);
+
+    log_set_timestamps(true);
+    log_set_thread_ids(true);
+    passed &= stress_run("sync, timestamps and thread ids", threads, lines, false, true);
+
+    //Async records are capped at LOG_ASYNC_RECORD_SIZE, so no long lines there
+    passed &= stress_run("async, timestamps and thread ids", threads, lines, true, false);
+
+    log_set_timestamps(false);
+    log_set_thread_ids(false);
+    passed &= stress_run("async", threads, lines, true, false);
+
+    if(passed == false){
+        error("torn, malformed or missing lines\n");
+        return 1;
+    }
+
+    okay("no line tore\n");
+    return 0;
+}